@@ -0,0 +1,23 @@
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+
+namespace day01 {
+
+struct parsed {
+	std::string text; // the non-empty lines, each one followed by a newline
+};
+
+parsed parse(std::string_view input);
+
+/// @brief appends the records of complete lines to already parsed input
+void parse_lines(parsed& res, std::string_view lines);
+
+uint64_t solve_part1(const parsed& input);
+uint64_t solve_part2(const parsed& input);
+
+}
@@ -0,0 +1,83 @@
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <utils/arena.hh>
+
+
+namespace day02 {
+
+struct cubes {
+    uint32_t red = 0;
+    uint32_t green = 0;
+    uint32_t blue = 0;
+
+    uint64_t power() const {
+        return static_cast<uint64_t>(red) * green * blue;
+    }
+};
+
+struct game {
+    uint32_t id;
+    std::pmr::vector<cubes> grabs;
+};
+
+struct parsed {
+    std::unique_ptr<arena> memory = std::make_unique<arena>();
+    std::pmr::vector<game> games { memory->resource() };
+};
+
+parsed parse(std::string_view input);
+
+/// @brief appends the records of complete lines to already parsed input
+void parse_lines(parsed& res, std::string_view lines);
+
+uint64_t solve_part1(const parsed& input);
+uint64_t solve_part2(const parsed& input);
+
+
+/// @brief the cubes of a grab or of a bag, written as in the games ("12 red, 13 green, 14 blue")
+cubes parse_cubes(std::string_view repr);
+
+/// @brief games reduced to the minimum bag making them possible, indexed once to answer any number of bag batches
+/// @note bag queries are answered offline : the games and the bags are swept by increasing red count,
+///       games being added to a Fenwick tree over their green ranks, each node of which is itself a Fenwick
+///       tree over the distinct blue ranks of the games it covers. The layout of the nodes only depends on
+///       the games and is built with the index, a batch only fills their sums. Each bag then sums the ids of
+///       the games whose green and blue counts are both within its own, in O(log G * log B) where G and B
+///       are the numbers of distinct green and blue counts among the games, with O(N log G) memory.
+class feasibility_index {
+
+public:
+    explicit feasibility_index(const parsed& input);
+
+    /// @brief for each bag, the sum of the ids of the games that are possible with it
+    std::vector<uint64_t> sum_possible_ids(std::span<const cubes> bags) const;
+
+private:
+    struct reduced_game {
+        uint32_t red;
+        uint32_t green_rank;
+        uint32_t blue_rank;
+        uint32_t id;
+    };
+
+    std::vector<reduced_game> _games; // sorted by red count
+    std::vector<uint32_t> _greens;    // distinct green counts, sorted
+    std::vector<uint32_t> _blues;     // distinct blue counts, sorted
+
+    // Node i (1-based) of the tree over the green ranks holds the blue ranks in [_node_offsets[i-1], _node_offsets[i])
+    std::vector<uint32_t> _node_offsets;
+    std::vector<uint32_t> _node_blue_ranks; // sorted and distinct within each node
+
+    std::span<const uint32_t> node_blue_ranks(size_t node) const;
+};
+
+
+}
@@ -0,0 +1,24 @@
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+#include <utils/grid.hh>
+
+
+namespace day03 {
+
+// The grid is surrounded by a border of '.', so that we never need to check the bounds
+using schematic = grid<char>;
+
+struct parsed {
+    schematic cells;
+};
+
+parsed parse(std::string_view input);
+
+uint64_t solve_part1(const parsed& input);
+uint64_t solve_part2(const parsed& input);
+
+}
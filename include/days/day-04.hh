@@ -0,0 +1,36 @@
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include <utils/arena.hh>
+
+
+namespace day04 {
+
+struct card {
+	explicit card(std::pmr::memory_resource* memory): we_have(memory), winning(memory) {}
+
+	std::pmr::unordered_set<uint32_t> we_have; 
+	std::pmr::unordered_set<uint32_t> winning; 
+};
+
+struct parsed {
+	std::unique_ptr<arena> memory = std::make_unique<arena>();
+	std::pmr::vector<card> cards { memory->resource() };
+};
+
+parsed parse(std::string_view input);
+
+/// @brief appends the records of complete lines to already parsed input
+void parse_lines(parsed& res, std::string_view lines);
+
+uint64_t solve_part1(const parsed& input);
+uint64_t solve_part2(const parsed& input);
+
+}
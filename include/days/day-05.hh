@@ -0,0 +1,61 @@
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+
+namespace day05 {
+
+class range_map {
+
+public:
+
+	struct entry {
+		uint32_t source_start;
+		uint32_t destination_start;
+		uint32_t length;
+	};
+
+	range_map(): _entries() {}
+
+	explicit range_map(const std::span<const entry> entries): _entries(entries.begin(), entries.end()) {}
+	
+	uint32_t operator[](const uint32_t val) const {
+		for(const entry& e: _entries) {
+			if(val >= e.source_start && (val - e.source_start) < e.length) {
+				return e.destination_start + (val - e.source_start);
+			}
+		}
+		return val;
+	}
+
+	void add_entry(const uint32_t source_start, const uint32_t destination_start, const uint32_t length) {
+		_entries.push_back({ source_start, destination_start, length });
+	}
+
+	std::span<const entry> entries() const { return _entries; }
+	
+private:
+	std::vector<entry> _entries;
+
+};
+
+struct parsed {
+	std::vector<uint32_t> seeds;
+	std::vector<range_map> maps;
+};
+
+parsed parse(std::string_view input);
+
+/// @brief writes the parsed input to a binary snapshot, that `load` maps back without parsing
+void save(const parsed& input, const std::filesystem::path& path);
+parsed load(const std::filesystem::path& path);
+
+uint32_t solve_part1(const parsed& input);
+uint32_t solve_part2(const parsed& input);
+
+}
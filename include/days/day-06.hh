@@ -0,0 +1,26 @@
+
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+
+namespace day06 {
+
+struct boat_race {
+	uint64_t duration;
+	uint64_t record;
+};
+
+struct parsed {
+	std::vector<boat_race> races; // one race per column
+	boat_race single_race;        // all the columns joined together
+};
+
+parsed parse(std::string_view input);
+
+uint64_t solve_part1(const parsed& input);
+uint64_t solve_part2(const parsed& input);
+
+}
@@ -0,0 +1,39 @@
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <utils/arena.hh>
+
+
+namespace day07 {
+
+struct hand {
+	std::pmr::string cards;
+	uint32_t bid;
+};
+
+struct parsed {
+	std::unique_ptr<arena> memory = std::make_unique<arena>();
+	std::pmr::vector<hand> hands { memory->resource() };
+};
+
+parsed parse(std::string_view input);
+
+/// @brief writes the parsed input to a binary snapshot, that `load` maps back without parsing
+void save(const parsed& input, const std::filesystem::path& path);
+parsed load(const std::filesystem::path& path);
+
+/// @brief appends the records of complete lines to already parsed input
+void parse_lines(parsed& res, std::string_view lines);
+
+uint64_t solve_part1(const parsed& input);
+uint64_t solve_part2(const parsed& input);
+
+}
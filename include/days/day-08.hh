@@ -0,0 +1,123 @@
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <utils/arena.hh>
+#include <utils/snapshot.hh>
+
+
+namespace day08 {
+
+/// @brief a node, with the position of its name in the names of the network and the indexes of its neighbours
+/// @note also the record of the snapshots, which are walked in place
+struct node_record {
+	uint32_t name_offset;
+	uint32_t name_length;
+	uint32_t left;
+	uint32_t right;
+};
+
+/// @brief view on nodes sorted by name and linked by index, that are either parsed or mapped from a snapshot
+class network {
+
+public:
+	network() = default;
+	network(const std::span<const char> names, const std::span<const node_record> nodes): _names(names), _nodes(nodes) {}
+
+	size_t size() const { return _nodes.size(); }
+
+	std::string_view name(const uint32_t node) const {
+		return std::string_view(_names.data() + _nodes[node].name_offset, _nodes[node].name_length);
+	}
+
+	uint32_t follow(const uint32_t node, const char lr) const {
+		return (lr == 'L') ? _nodes[node].left : _nodes[node].right;
+	}
+
+	/// @brief index of the node with the given name, found by binary search
+	std::optional<uint32_t> find(const std::string_view name) const {
+		size_t low = 0;
+		size_t high = _nodes.size();
+		while(low < high) {
+			const size_t mid = low + (high - low) / 2;
+			if(this->name(mid) < name) {
+				low = mid + 1;
+			} else {
+				high = mid;
+			}
+		}
+		if(low == _nodes.size() || this->name(low) != name) {
+			return std::nullopt;
+		}
+		return static_cast<uint32_t>(low);
+	}
+
+	std::span<const char> names() const { return _names; }
+	std::span<const node_record> records() const { return _nodes; }
+
+private:
+	std::span<const char> _names;
+	std::span<const node_record> _nodes;
+
+};
+
+struct parsed {
+	std::unique_ptr<arena> memory = std::make_unique<arena>();
+	std::string directions;
+	std::pmr::vector<char> names { memory->resource() };          // storage of the network when it is parsed
+	std::pmr::vector<node_record> records { memory->resource() };
+	std::unique_ptr<const snapshot> mapping = nullptr;             // storage of the network when it is loaded
+	network nodes = {};                                            // on one of the storages above
+};
+
+parsed parse(std::string_view input);
+
+/// @brief writes the parsed input to a binary snapshot, that `load` maps back without parsing
+void save(const parsed& input, const std::filesystem::path& path);
+/// @note the network is walked in the mapping, only checked and never copied
+parsed load(const std::filesystem::path& path);
+
+
+/// @brief jump table over full passes of the directions, built once per network to answer many start/destination queries
+class pass_table {
+
+public:
+	pass_table(const network& nodes, const std::string& directions);
+
+	/// @brief number of steps to get from start to destination, if both exist and the destination is ever reached
+	/// @note the hits of each destination are computed by its first query, and reused by the next ones
+	std::optional<uint64_t> steps(std::string_view start, std::string_view destination);
+
+private:
+	struct destination_hits {
+		std::vector<uint32_t> first_offset;         // _directions.size() if not visited during the pass
+		std::vector<std::vector<uint8_t>> in_block; // in_block[k][i] : visited during the 2^k passes from i
+	};
+
+	const network _nodes; // the storage of the network must outlive the table
+	const std::string _directions;
+	std::vector<std::vector<uint32_t>> _jumps; // _jumps[k][i] : node reached after 2^k passes from i
+	std::unordered_map<uint32_t,destination_hits> _hits;
+
+	const destination_hits& hits_for(uint32_t destination);
+
+};
+
+
+/// @brief number of steps from AAA to ZZZ
+std::optional<uint64_t> solve_part1(const parsed& input);
+
+/// @brief number of steps until all the walkers starting on **A are simultaneously on **Z
+std::optional<uint64_t> solve_part2(const parsed& input);
+
+}
@@ -0,0 +1,54 @@
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <vector>
+
+#include <utils/arena.hh>
+#include <utils/decompress.hh>
+
+
+namespace day09 {
+
+using sequence = std::pmr::vector<int32_t>;
+
+struct parsed {
+    std::unique_ptr<arena> memory = std::make_unique<arena>();
+    std::pmr::vector<sequence> values { memory->resource() }; // the sequences are allocated in the same arena
+};
+
+parsed parse(std::string_view input);
+
+/// @brief appends the records of complete lines to already parsed input
+void parse_lines(parsed& res, std::string_view lines);
+
+
+enum class engine {
+    iterative,   // one difference table per sequence
+    closed_form, // one dot product with cached binomial weights per sequence
+    batched      // sequences of the same length processed together in SIMD lanes
+};
+
+/// @brief sum of the next values
+int64_t solve_part1(const parsed& input, engine e = engine::iterative);
+
+/// @brief sum of the previous values
+int64_t solve_part2(const parsed& input, engine e = engine::iterative);
+
+
+struct extrapolation_sums {
+    int64_t next = 0;
+    int64_t previous = 0;
+};
+
+/// @brief both parts at once, with the batched engine
+extrapolation_sums solve_both(const parsed& input);
+
+/// @brief both parts at once, reading the sequences batch by batch with constant memory
+/// @note compressed input is decompressed by the source, like for the other input paths
+extrapolation_sums solve_streaming(input_source& source);
+
+}
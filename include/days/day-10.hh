@@ -0,0 +1,143 @@
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <utils/grid.hh>
+#include <utils/output.hh>
+
+
+namespace day10 {
+
+enum class pipe_joint : uint8_t {
+    lr,
+    bt,
+    bl,
+    br,
+    tl,
+    tr,
+    none
+};
+
+
+enum class displacement {
+    top,
+    right,
+    bottom,
+    left
+};
+
+struct coordinate {
+    size_t x;
+    size_t y;
+
+    bool operator!=(const coordinate& other) const {
+        return (x != other.x) || (y != other.y);
+    }
+};
+
+struct pipe_layout {
+    grid<pipe_joint> tiles;          // only the tiles of the loop, surrounded by a border of empty tiles
+    coordinate start_position;
+    displacement start_displacement;
+
+    // Loop metadata, recorded while tracing the loop
+    uint64_t loop_length;
+    std::vector<coordinate> corners; // in the order of the loop, the start comes last if it is a corner
+    coordinate top_left;             // bounding box of the loop (inclusive)
+    coordinate bottom_right;
+    packed_grid<1> on_loop;
+
+    bool is_on_loop(const coordinate& c) const {
+        return on_loop.get(c.x, c.y);
+    }
+
+    pipe_joint& operator[](const coordinate& c) {
+        return tiles(c.x, c.y);
+    }
+
+    pipe_joint operator[](const coordinate& c) const {
+        return tiles(c.x, c.y);
+    }
+
+};
+
+
+std::ostream& operator<<(std::ostream& out, const coordinate& c);
+std::ostream& operator<<(std::ostream& out, const displacement d);
+std::ostream& operator<<(std::ostream& out, const pipe_joint p);
+std::ostream& operator<<(std::ostream& out, const pipe_layout& layout);
+
+/// @brief the box-drawing character of the joint, or a space
+std::string_view glyph(const pipe_joint p);
+
+output_buffer& operator<<(output_buffer& out, const pipe_joint p);
+output_buffer& operator<<(output_buffer& out, const pipe_layout& layout);
+
+
+/// @brief tiles enclosed by the loop, one bit per tile, with the number of enclosed tiles in each row
+class inside_mask {
+
+public:
+    inside_mask(const size_t width, const size_t height): _bits(width, height), _row_counts(height, 0) {}
+
+    size_t width()  const { return _bits.width();  }
+    size_t height() const { return _bits.height(); }
+
+    bool operator[](const coordinate& c) const {
+        return _bits.get(c.x, c.y);
+    }
+
+    std::span<uint64_t> row(const size_t y) { return _bits.row(y); }
+
+    uint32_t& row_count(const size_t y)       { return _row_counts[y]; }
+    uint32_t  row_count(const size_t y) const { return _row_counts[y]; }
+
+    uint64_t count() const {
+        uint64_t res = 0;
+        for(const uint32_t c: _row_counts) {
+            res += c;
+        }
+        return res;
+    }
+
+private:
+    packed_grid<1> _bits;
+    std::vector<uint32_t> _row_counts;
+
+};
+
+
+using parsed = pipe_layout;
+
+parsed parse(std::string_view input);
+
+/// @brief writes the parsed input to a binary snapshot, that `load` maps back without parsing
+void save(const parsed& input, const std::filesystem::path& path);
+parsed load(const std::filesystem::path& path);
+
+
+/// @brief number of steps to get to the farthest point of the loop
+uint64_t solve_part1(const parsed& input);
+
+
+enum class engine {
+    scanline, // parity of the number of crossings along each row
+    shoelace, // area of the loop and Pick's theorem
+    flood     // flood fill of the corners of the tiles from the outside
+};
+
+/// @brief number of tiles enclosed by the loop
+uint64_t solve_part2(const parsed& input, engine e = engine::scanline);
+
+inside_mask classify_scanline(const pipe_layout& layout);
+
+/// @brief draws the layout, with the enclosed tiles marked with an O
+void render(output_buffer& out, const pipe_layout& layout, const inside_mask& mask);
+
+}
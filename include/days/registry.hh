@@ -0,0 +1,22 @@
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+
+/// @brief type-erased entry point of a day, so that days can be selected at runtime
+struct day_solver {
+    std::string_view day;
+
+    /// @brief parses the input and solves the requested part, or nullopt if the puzzle has no solution
+    std::optional<std::string> (*solve)(std::string_view input, bool part2);
+};
+
+/// @brief all the days, in order
+std::span<const day_solver> all_days();
+
+/// @brief the solver of a day, given as "7" or "07", or nullptr if the day does not exist
+const day_solver* find_day(std::string_view day);
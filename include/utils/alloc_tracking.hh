@@ -0,0 +1,58 @@
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include <sys/resource.h>
+
+
+/*
+ |  Allocation accounting, for the instrumentation build (AOC_ALLOC_TRACKING,
+ |  meson option alloc_tracking).
+ |
+ |  That build links src/lib/alloc_tracking.cc, which replaces the global
+ |  operator new and operator delete to count, for the calling thread, the
+ |  allocations, the allocated bytes and the live bytes. Phases (utils/perf.hh)
+ |  take the difference of these counters between their start and their end.
+ |
+ |  The counters are per thread so that the phases of the batch runner's
+ |  workers do not see each other's allocations. Memory released by another
+ |  thread than the one that allocated it makes the live bytes of the first
+ |  one drift, which only matters for the pipelined parsers.
+ */
+
+struct alloc_counters {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    int64_t live = 0;
+    int64_t peak = 0;  // highest live bytes since the last reset by a phase
+};
+
+#ifdef AOC_ALLOC_TRACKING
+
+constexpr bool alloc_tracking_enabled = true;
+
+/// @brief counters of the calling thread, updated by the replaced operator new and operator delete
+alloc_counters& thread_alloc_counters() noexcept;
+
+#else
+
+constexpr bool alloc_tracking_enabled = false;
+
+inline alloc_counters& thread_alloc_counters() noexcept {
+    static thread_local alloc_counters res;  // stays at zero
+    return res;
+}
+
+#endif
+
+
+/// @brief highest resident set size of the process so far, in bytes
+inline std::optional<uint64_t> peak_rss_bytes() {
+    rusage usage {};
+    if(getrusage(RUSAGE_SELF, &usage) != 0) {
+        return std::nullopt;
+    }
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;  // KiB on Linux
+}
@@ -0,0 +1,73 @@
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+#include <sys/mman.h>
+
+
+/// @brief upstream resource handing out anonymous mappings, rounded to and advised as transparent huge pages
+/// @note only meant to feed a monotonic buffer, which asks for few large blocks
+class huge_page_resource : public std::pmr::memory_resource {
+
+public:
+    static constexpr size_t huge_page_size = static_cast<size_t>(2) << 20;
+
+    static huge_page_resource* instance() {
+        static huge_page_resource res;
+        return &res;
+    }
+
+private:
+    static size_t rounded(const size_t bytes) {
+        return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+    }
+
+    void* do_allocate(const size_t bytes, const size_t) override {
+        const size_t length = rounded(bytes);
+        void* res = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if(res == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        madvise(res, length, MADV_HUGEPAGE);
+        return res;
+    }
+
+    void do_deallocate(void* p, const size_t bytes, const size_t) override {
+        munmap(p, rounded(bytes));
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+};
+
+
+/// @brief monotonic memory for parse-time data structures, released all at once when the arena is destroyed
+/// @note the arena must outlive every container using it, keep it as the first member of the structure owning them.
+///       Arenas expected to hold at least a huge page are backed by huge pages.
+class arena {
+
+public:
+    static constexpr size_t default_initial_size = static_cast<size_t>(64) << 10;
+
+    explicit arena(const size_t expected_size = default_initial_size):
+        _resource(
+            std::max(expected_size, default_initial_size),
+            (expected_size >= huge_page_resource::huge_page_size) ? static_cast<std::pmr::memory_resource*>(huge_page_resource::instance())
+                                                                   : std::pmr::new_delete_resource()
+        ) {}
+
+    arena(const arena&) = delete;
+    arena& operator=(const arena&) = delete;
+
+    std::pmr::memory_resource* resource() { return &_resource; }
+
+private:
+    std::pmr::monotonic_buffer_resource _resource;
+
+};
@@ -0,0 +1,44 @@
+
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+
+inline bool has_flag(const int argc, char** argv, const std::string_view flag) {
+    for(int i = 1; i < argc; i++) {
+        if(flag == argv[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+/// @brief the argument following a flag, for flags taking a value (e.g. "--threads 8")
+inline std::optional<std::string_view> flag_value(const int argc, char** argv, const std::string_view flag) {
+    for(int i = 1; i + 1 < argc; i++) {
+        if(flag == argv[i]) {
+            return argv[i + 1];
+        }
+    }
+    return std::nullopt;
+}
+
+
+/// @brief the arguments that are neither flags nor the values of the given flags taking one
+inline std::vector<std::string_view> positional_arguments(const int argc, char** argv, const std::initializer_list<std::string_view> value_flags = {}) {
+    std::vector<std::string_view> res;
+    for(int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+        if(std::find(value_flags.begin(), value_flags.end(), arg) != value_flags.end()) {
+            i++;
+        } else if(!arg.starts_with("--")) {
+            res.push_back(arg);
+        }
+    }
+    return res;
+}
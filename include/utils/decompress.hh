@@ -0,0 +1,246 @@
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <poll.h>
+#include <unistd.h>
+
+#ifdef AOC_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef AOC_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+
+enum class compression { none, gzip, zstd };
+
+
+/*
+ |  Byte source over a file descriptor, that recognises gzip and zstd streams by
+ |  their magic number and decompresses them on the fly. The compressed data is
+ |  read in large blocks, and several concatenated frames or members are
+ |  decompressed one after the other, as zcat and zstdcat do.
+ |
+ |  The support of each format depends on the library being found at build time
+ |  (AOC_HAVE_ZLIB, AOC_HAVE_ZSTD), compressed input of an unsupported format is
+ |  reported with an exception rather than being handed over as is.
+ */
+class input_source {
+
+public:
+    static constexpr size_t block_size = static_cast<size_t>(1) << 20;
+    static constexpr int stop_check_interval = 50; // milliseconds
+
+    explicit input_source(const int fd = STDIN_FILENO): _fd(fd), _in(block_size) {
+        // the magic numbers are read as the start of the first block
+        while(_in_end < 4 && !_eof) {
+            _in_end += fill_from_fd(_in.data() + _in_end, 4 - _in_end);
+        }
+        _format = detect(_in.data(), _in_end);
+        init_decoder();
+    }
+
+    input_source(const input_source&) = delete;
+    input_source& operator=(const input_source&) = delete;
+
+    ~input_source() {
+#ifdef AOC_HAVE_ZLIB
+        if(_format == compression::gzip) {
+            inflateEnd(&_gzip);
+        }
+#endif
+#ifdef AOC_HAVE_ZSTD
+        if(_format == compression::zstd) {
+            ZSTD_freeDStream(_zstd);
+        }
+#endif
+    }
+
+    compression format() const { return _format; }
+
+    /// @brief makes the pending and next reads return 0 (end of input), may be called from another thread
+    /// @note reads wait for data in slices of `stop_check_interval`, so a blocked read returns within one slice
+    void request_stop() {
+        _stop.store(true, std::memory_order_relaxed);
+    }
+
+    /// @brief reads up to `size` bytes of (decompressed) input, 0 only at the end of the input
+    size_t read(char* out, const size_t size) {
+        switch(_format) {
+            case compression::gzip: return read_gzip(out, size);
+            case compression::zstd: return read_zstd(out, size);
+            default:                return read_plain(out, size);
+        }
+    }
+
+private:
+    const int _fd;
+    compression _format = compression::none;
+    std::vector<char> _in;
+    size_t _in_begin = 0;
+    size_t _in_end = 0;
+    bool _eof = false;
+    bool _in_frame = false; // a gzip member or zstd frame has been started but not finished
+    std::atomic<bool> _stop = false;
+
+#ifdef AOC_HAVE_ZLIB
+    z_stream _gzip {};
+#endif
+#ifdef AOC_HAVE_ZSTD
+    ZSTD_DStream* _zstd = nullptr;
+#endif
+
+    static compression detect(const char* data, const size_t size) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(data);
+        if(size >= 2 && bytes[0] == 0x1f && bytes[1] == 0x8b) {
+            return compression::gzip;
+        }
+        if(size >= 4 && bytes[0] == 0x28 && bytes[1] == 0xb5 && bytes[2] == 0x2f && bytes[3] == 0xfd) {
+            return compression::zstd;
+        }
+        return compression::none;
+    }
+
+    size_t fill_from_fd(char* out, const size_t size) {
+        while(true) {
+            if(_stop.load(std::memory_order_relaxed)) {
+                _eof = true;
+                return 0;
+            }
+            // wait for data without blocking in read, so that a stop request is noticed
+            pollfd ready { _fd, POLLIN, 0 };
+            const int nb_ready = ::poll(&ready, 1, stop_check_interval);
+            if(nb_ready == 0 || (nb_ready < 0 && errno == EINTR)) {
+                continue;
+            }
+            const ssize_t nb_read = ::read(_fd, out, size);
+            if(nb_read < 0 && errno == EINTR) {
+                continue;
+            }
+            if(nb_read <= 0) {
+                _eof = true;
+                return 0;
+            }
+            return static_cast<size_t>(nb_read);
+        }
+    }
+
+    /// @brief makes sure that there are compressed bytes to consume, false at the end of the input
+    bool refill() {
+        if(_in_begin < _in_end) {
+            return true;
+        }
+        _in_begin = 0;
+        _in_end = _eof ? 0 : fill_from_fd(_in.data(), _in.size());
+        return _in_end > 0;
+    }
+
+    void init_decoder() {
+        switch(_format) {
+            case compression::gzip:
+#ifdef AOC_HAVE_ZLIB
+                if(inflateInit2(&_gzip, 15 + 16) != Z_OK) {
+                    throw std::runtime_error("cannot initialise the gzip decoder");
+                }
+                return;
+#else
+                throw std::runtime_error("the input is gzip-compressed, but the program was built without zlib");
+#endif
+            case compression::zstd:
+#ifdef AOC_HAVE_ZSTD
+                _zstd = ZSTD_createDStream();
+                if(_zstd == nullptr || ZSTD_isError(ZSTD_initDStream(_zstd))) {
+                    throw std::runtime_error("cannot initialise the zstd decoder");
+                }
+                return;
+#else
+                throw std::runtime_error("the input is zstd-compressed, but the program was built without libzstd");
+#endif
+            default:
+                return;
+        }
+    }
+
+    size_t read_plain(char* out, const size_t size) {
+        if(_in_begin < _in_end) {
+            const size_t res = std::min(size, _in_end - _in_begin);
+            std::memcpy(out, _in.data() + _in_begin, res);
+            _in_begin += res;
+            return res;
+        }
+        return _eof ? 0 : fill_from_fd(out, size);
+    }
+
+    size_t read_gzip([[maybe_unused]] char* out, [[maybe_unused]] const size_t size) {
+#ifdef AOC_HAVE_ZLIB
+        _gzip.next_out = reinterpret_cast<Bytef*>(out);
+        const uInt capacity = static_cast<uInt>(std::min<size_t>(size, UINT32_MAX));
+        _gzip.avail_out = capacity;
+        while(_gzip.avail_out > 0) {
+            if(!refill()) {
+                if(_in_frame) {
+                    throw std::runtime_error("truncated gzip input : the input ends in the middle of a member");
+                }
+                break;
+            }
+            _gzip.next_in = reinterpret_cast<Bytef*>(_in.data() + _in_begin);
+            _gzip.avail_in = static_cast<uInt>(_in_end - _in_begin);
+            const int status = inflate(&_gzip, Z_NO_FLUSH);
+            _in_begin = _in_end - _gzip.avail_in;
+            if(status == Z_STREAM_END) {
+                inflateReset(&_gzip); // another member may follow
+                _in_frame = false;
+            } else if(status == Z_OK || status == Z_BUF_ERROR) {
+                _in_frame = true; // Z_BUF_ERROR : no progress until more input is available
+            } else {
+                throw std::runtime_error(std::string("corrupted gzip input : ") + (_gzip.msg ? _gzip.msg : "unknown error"));
+            }
+            if(_gzip.avail_out < capacity) {
+                break; // hand over what is available rather than waiting for more input
+            }
+        }
+        return capacity - _gzip.avail_out;
+#else
+        return 0;
+#endif
+    }
+
+    size_t read_zstd([[maybe_unused]] char* out, [[maybe_unused]] const size_t size) {
+#ifdef AOC_HAVE_ZSTD
+        ZSTD_outBuffer output { out, size, 0 };
+        while(output.pos < output.size) {
+            if(!refill()) {
+                if(_in_frame) {
+                    throw std::runtime_error("truncated zstd input : the input ends in the middle of a frame");
+                }
+                break;
+            }
+            ZSTD_inBuffer input { _in.data() + _in_begin, _in_end - _in_begin, 0 };
+            const size_t status = ZSTD_decompressStream(_zstd, &output, &input);
+            _in_begin += input.pos;
+            if(ZSTD_isError(status)) {
+                throw std::runtime_error(std::string("corrupted zstd input : ") + ZSTD_getErrorName(status));
+            }
+            _in_frame = (status != 0); // 0 once a frame is complete and flushed
+            if(output.pos > 0) {
+                break; // hand over what is available rather than waiting for more input
+            }
+        }
+        return output.pos;
+#else
+        return 0;
+#endif
+    }
+
+};
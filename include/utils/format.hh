@@ -1,8 +1,34 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string_view>
 
-inline bool is_number(const char c) {
+
+constexpr bool is_number(const char c) {
 	return (c >= '0') && (c <= '9');
 }
 
+
+/// @brief value of the digits at the start of the string, stopping at the first other character
+constexpr uint64_t parse_unsigned(const std::string_view repr) {
+	uint64_t res = 0;
+	for(const char c: repr) {
+		if(!is_number(c)) {
+			break;
+		}
+		res = res * 10 + static_cast<uint64_t>(c - '0');
+	}
+	return res;
+}
+
+/// @brief value of all the digits of the string put together, ignoring the other characters
+constexpr uint64_t parse_digits(const std::string_view repr) {
+	uint64_t res = 0;
+	for(const char c: repr) {
+		if(is_number(c)) {
+			res = res * 10 + static_cast<uint64_t>(c - '0');
+		}
+	}
+	return res;
+}
@@ -0,0 +1,112 @@
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+/// @brief two-dimensional grid stored contiguously, surrounded by a border of sentinel cells
+/// @note (x, y) coordinates exclude the border, linear indexes include it,
+///       so that the neighbours of any inner cell can be accessed without bounds checks
+template <typename T, size_t Border = 1>
+class grid {
+
+public:
+    grid(): grid(0, 0) {}
+
+    grid(const size_t width, const size_t height, const T& sentinel = T()):
+        _width(width), _height(height), _stride(width + 2*Border), _cells(_stride * (height + 2*Border), sentinel) {}
+
+    size_t width()  const { return _width;  }
+    size_t height() const { return _height; }
+    size_t stride() const { return _stride; }
+    size_t size()   const { return _cells.size(); }
+
+    size_t index(const size_t x, const size_t y) const { return (y + Border) * _stride + (x + Border); }
+    size_t x_of(const size_t i) const { return i % _stride - Border; }
+    size_t y_of(const size_t i) const { return i / _stride - Border; }
+
+    /// @brief offset of the neighbour at (dx, dy) in linear indexes
+    std::ptrdiff_t offset(const std::ptrdiff_t dx, const std::ptrdiff_t dy) const {
+        return dy * static_cast<std::ptrdiff_t>(_stride) + dx;
+    }
+
+    /// @brief offsets of the 8 neighbours, starting from the top left one in reading order
+    std::array<std::ptrdiff_t,8> neighbour_offsets() const {
+        return {
+            offset(-1, -1), offset(0, -1), offset(1, -1),
+            offset(-1,  0),                offset(1,  0),
+            offset(-1,  1), offset(0,  1), offset(1,  1)
+        };
+    }
+
+    T&       operator[](const size_t i)       { return _cells[i]; }
+    const T& operator[](const size_t i) const { return _cells[i]; }
+
+    T&       operator()(const size_t x, const size_t y)       { return _cells[index(x, y)]; }
+    const T& operator()(const size_t x, const size_t y) const { return _cells[index(x, y)]; }
+
+    /// @brief the inner cells of a row, without the border
+    std::span<T>       row(const size_t y)       { return std::span<T>(_cells.data() + index(0, y), _width);       }
+    std::span<const T> row(const size_t y) const { return std::span<const T>(_cells.data() + index(0, y), _width); }
+
+    T*       data()       { return _cells.data(); }
+    const T* data() const { return _cells.data(); }
+
+private:
+    size_t _width;
+    size_t _height;
+    size_t _stride;
+    std::vector<T> _cells;
+
+};
+
+
+/// @brief grid of small unsigned values (1, 2 or 4 bits per cell), packed in 64-bit words
+/// @note each row starts on a new word, so that different rows can be written concurrently
+template <size_t Bits>
+class packed_grid {
+
+    static_assert(Bits == 1 || Bits == 2 || Bits == 4, "cells must not straddle two words");
+
+public:
+    static constexpr size_t cells_per_word = 64 / Bits;
+    static constexpr uint64_t cell_mask = (static_cast<uint64_t>(1) << Bits) - 1;
+
+    packed_grid(): packed_grid(0, 0) {}
+
+    packed_grid(const size_t width, const size_t height):
+        _width(width), _height(height), _words_per_row((width + cells_per_word - 1) / cells_per_word), _words(_words_per_row * height, 0) {}
+
+    size_t width()  const { return _width;  }
+    size_t height() const { return _height; }
+    size_t words_per_row() const { return _words_per_row; }
+
+    uint8_t get(const size_t x, const size_t y) const {
+        const uint64_t word = _words[y * _words_per_row + x / cells_per_word];
+        return static_cast<uint8_t>((word >> ((x % cells_per_word) * Bits)) & cell_mask);
+    }
+
+    void set(const size_t x, const size_t y, const uint8_t value) {
+        uint64_t& word = _words[y * _words_per_row + x / cells_per_word];
+        const size_t shift = (x % cells_per_word) * Bits;
+        word = (word & ~(cell_mask << shift)) | ((static_cast<uint64_t>(value) & cell_mask) << shift);
+    }
+
+    std::span<uint64_t>       row(const size_t y)       { return std::span<uint64_t>(_words.data() + y * _words_per_row, _words_per_row);       }
+    std::span<const uint64_t> row(const size_t y) const { return std::span<const uint64_t>(_words.data() + y * _words_per_row, _words_per_row); }
+
+    /// @brief all the words, row after row
+    std::span<uint64_t>       words()       { return _words; }
+    std::span<const uint64_t> words() const { return _words; }
+
+private:
+    size_t _width;
+    size_t _height;
+    size_t _words_per_row;
+    std::vector<uint64_t> _words;
+
+};
@@ -1,8 +1,20 @@
 
 #pragma once
 
+#include <algorithm>
+#include <filesystem>
 #include <optional>
 #include <iostream>
+#include <string>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <utils/decompress.hh>
+#include <utils/pipeline.hh>
 
 
 inline std::optional<std::string> read_line() {
@@ -17,3 +29,83 @@ inline std::optional<std::string> read_line() {
 	return std::make_optional<std::string>(std::move(line));
 }
 
+
+/// @brief reads everything left in the source, decompressing it on the calling thread
+inline std::string read_source(input_source& source) {
+	std::string res;
+	size_t size = 0;
+	res.resize(static_cast<size_t>(1) << 16);
+	while(true) {
+		if(size == res.size()) {
+			res.resize(2 * res.size());
+		}
+		const size_t nb_read = source.read(res.data() + size, res.size() - size);
+		if(nb_read == 0) {
+			break;
+		}
+		size += nb_read;
+	}
+	res.resize(size);
+	return res;
+}
+
+
+/// @brief reads the whole standard input at once
+/// @note gzip and zstd input is decompressed on a reader thread, while the previous blocks are being copied
+inline std::string read_all() {
+	input_source source(STDIN_FILENO);
+	if(source.format() == compression::none) {
+		return read_source(source);
+	}
+	std::string res;
+	for_each_line_batch([&res](const std::string_view lines) { res.append(lines); }, source);
+	return res;
+}
+
+
+/// @brief reads a whole file at once, or nullopt if it cannot be opened
+/// @note compressed files are decompressed on the calling thread
+inline std::optional<std::string> read_file(const std::filesystem::path& path) {
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if(fd < 0) {
+		return std::nullopt;
+	}
+	std::optional<std::string> res;
+	try {
+		input_source source(fd);
+		res = read_source(source);
+	} catch(...) {
+		::close(fd);
+		throw;
+	}
+	::close(fd);
+	return res;
+}
+
+/// @brief the contents of a file, or of the standard input for "-"
+inline std::optional<std::string> read_path(const std::string_view path) {
+	return (path == "-") ? std::make_optional(read_all()) : read_file(std::string(path));
+}
+
+
+/// @brief the input files: directories are expanded to the regular files they contain, sorted by name,
+///        the other paths are kept in the order they were given
+inline std::vector<std::filesystem::path> list_inputs(const std::span<const std::string_view> paths) {
+	std::vector<std::filesystem::path> res;
+	for(const std::string_view path: paths) {
+		std::error_code error;
+		if(std::filesystem::is_directory(path, error)) {
+			std::vector<std::filesystem::path> files;
+			for(const std::filesystem::directory_entry& entry: std::filesystem::directory_iterator(path, error)) {
+				if(entry.is_regular_file(error)) {
+					files.push_back(entry.path());
+				}
+			}
+			std::sort(files.begin(), files.end());
+			res.insert(res.end(), files.begin(), files.end());
+		} else {
+			res.emplace_back(path);
+		}
+	}
+	return res;
+}
@@ -0,0 +1,239 @@
+
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+
+/// @brief writes the string quoted and escaped, to a std::ostream or an output_buffer
+template <typename Out>
+void write_json_string(Out& out, const std::string_view str) {
+    out << '"';
+    for(const char c: str) {
+        switch(c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n";  break;
+            case '\t': out << "\\t";  break;
+            default:
+                if(static_cast<unsigned char>(c) < 0x20) {
+                    constexpr std::string_view hex = "0123456789abcdef";
+                    out << "\\u00" << hex[c >> 4] << hex[c & 0xf];
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+
+/*
+ |  Minimal JSON reader, for the files the programs of this repository write
+ |  themselves (benchmark baselines). Objects keep their members in order, as
+ |  a list of pairs, and all numbers are read as doubles. \uXXXX escapes are
+ |  only supported for ASCII characters. Malformed documents throw.
+ */
+
+struct json_value;
+
+using json_array = std::vector<json_value>;
+using json_object = std::vector<std::pair<std::string,json_value>>;
+
+struct json_value {
+    std::variant<std::nullptr_t,bool,double,std::string,json_array,json_object> value;
+
+    bool is_null() const { return std::holds_alternative<std::nullptr_t>(value); }
+
+    double as_number() const { return get<double>("a number"); }
+    const std::string& as_string() const { return get<std::string>("a string"); }
+    const json_array& as_array() const { return get<json_array>("an array"); }
+    const json_object& as_object() const { return get<json_object>("an object"); }
+
+    /// @brief the member of an object with the given key, which must exist
+    const json_value& operator[](const std::string_view key) const {
+        for(const auto& [k, v]: as_object()) {
+            if(k == key) {
+                return v;
+            }
+        }
+        throw std::runtime_error("missing JSON member \"" + std::string(key) + "\"");
+    }
+
+private:
+    template <typename T>
+    const T& get(const char* expected) const {
+        if(const T* res = std::get_if<T>(&value); res != nullptr) {
+            return *res;
+        }
+        throw std::runtime_error(std::string("expected ") + expected + " in the JSON document");
+    }
+};
+
+
+class json_reader {
+
+public:
+    explicit json_reader(const std::string_view text): _text(text) {}
+
+    json_value read_document() {
+        json_value res = read_value();
+        skip_spaces();
+        if(_pos != _text.length()) {
+            fail("trailing characters");
+        }
+        return res;
+    }
+
+private:
+    const std::string_view _text;
+    size_t _pos = 0;
+
+    [[noreturn]] void fail(const std::string_view reason) const {
+        throw std::runtime_error("invalid JSON at offset " + std::to_string(_pos) + " : " + std::string(reason));
+    }
+
+    void skip_spaces() {
+        while(_pos < _text.length() && (_text[_pos] == ' ' || _text[_pos] == '\n' || _text[_pos] == '\t' || _text[_pos] == '\r')) {
+            _pos++;
+        }
+    }
+
+    bool consume(const char c) {
+        skip_spaces();
+        if(_pos < _text.length() && _text[_pos] == c) {
+            _pos++;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(const char c) {
+        if(!consume(c)) {
+            fail(std::string("expected '") + c + "'");
+        }
+    }
+
+    bool consume_word(const std::string_view word) {
+        if(_text.substr(_pos, word.length()) == word) {
+            _pos += word.length();
+            return true;
+        }
+        return false;
+    }
+
+    json_value read_value() {
+        skip_spaces();
+        if(_pos == _text.length()) {
+            fail("unexpected end");
+        }
+        switch(_text[_pos]) {
+            case '{': return { read_object() };
+            case '[': return { read_array() };
+            case '"': return { read_string() };
+            default: break;
+        }
+        if(consume_word("null"))  { return { nullptr }; }
+        if(consume_word("true"))  { return { true }; }
+        if(consume_word("false")) { return { false }; }
+        return { read_number() };
+    }
+
+    json_object read_object() {
+        json_object res;
+        expect('{');
+        if(consume('}')) {
+            return res;
+        }
+        do {
+            skip_spaces();
+            std::string key = read_string();
+            expect(':');
+            res.emplace_back(std::move(key), read_value());
+        } while(consume(','));
+        expect('}');
+        return res;
+    }
+
+    json_array read_array() {
+        json_array res;
+        expect('[');
+        if(consume(']')) {
+            return res;
+        }
+        do {
+            res.push_back(read_value());
+        } while(consume(','));
+        expect(']');
+        return res;
+    }
+
+    std::string read_string() {
+        if(_pos == _text.length() || _text[_pos] != '"') {
+            fail("expected a string");
+        }
+        _pos++;
+        std::string res;
+        while(_pos < _text.length() && _text[_pos] != '"') {
+            char c = _text[_pos++];
+            if(c == '\\') {
+                if(_pos == _text.length()) {
+                    fail("unterminated escape");
+                }
+                switch(_text[_pos++]) {
+                    case '"':  c = '"';  break;
+                    case '\\': c = '\\'; break;
+                    case '/':  c = '/';  break;
+                    case 'b':  c = '\b'; break;
+                    case 'f':  c = '\f'; break;
+                    case 'n':  c = '\n'; break;
+                    case 'r':  c = '\r'; break;
+                    case 't':  c = '\t'; break;
+                    case 'u':  c = read_ascii_escape(); break;
+                    default:   fail("unknown escape");
+                }
+            }
+            res.push_back(c);
+        }
+        if(_pos == _text.length()) {
+            fail("unterminated string");
+        }
+        _pos++;
+        return res;
+    }
+
+    char read_ascii_escape() {
+        unsigned int code = 0;
+        const char* begin = _text.data() + _pos;
+        const auto [ptr, ec] = std::from_chars(begin, begin + std::min<size_t>(4, _text.length() - _pos), code, 16);
+        if(ec != std::errc() || ptr != begin + 4 || code >= 0x80) {
+            fail("unsupported \\u escape");
+        }
+        _pos += 4;
+        return static_cast<char>(code);
+    }
+
+    double read_number() {
+        const char* begin = _text.data() + _pos;
+        double res = 0;
+        const auto [ptr, ec] = std::from_chars(begin, _text.data() + _text.length(), res);
+        if(ec != std::errc()) {
+            fail("expected a value");
+        }
+        _pos += static_cast<size_t>(ptr - begin);
+        return res;
+    }
+
+};
+
+inline json_value parse_json(const std::string_view text) {
+    return json_reader(text).read_document();
+}
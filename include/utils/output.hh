@@ -0,0 +1,140 @@
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+
+/*
+ |  Buffered output for the results : values are formatted in place at the end
+ |  of a large buffer (numbers with std::to_chars, without locale nor stream
+ |  state), and the buffer is handed to the file descriptor with write(2) when
+ |  it is full, when flush() is called and when it is destroyed. A program
+ |  printing its results through standard_output() thus makes a single system
+ |  call, whatever the number of lines.
+ |
+ |  Nothing is synchronised with std::cout : a program writes its results
+ |  through one or the other, not both.
+ */
+
+class output_buffer {
+
+public:
+    static constexpr size_t default_capacity = static_cast<size_t>(1) << 20;
+
+    explicit output_buffer(const int fd, const size_t capacity = default_capacity): _fd(fd) {
+        _buffer.resize(std::max<size_t>(capacity, 64));
+    }
+
+    output_buffer(const output_buffer&) = delete;
+    output_buffer& operator=(const output_buffer&) = delete;
+
+    ~output_buffer() {
+        try {
+            flush();
+        } catch(const std::system_error&) {
+            // nowhere left to report it
+        }
+    }
+
+    /// @brief writes the buffered bytes to the file descriptor
+    void flush() {
+        write_all(_buffer.data(), _size);
+        _size = 0;
+    }
+
+    output_buffer& operator<<(const std::string_view str) {
+        if(str.length() > _buffer.size() - _size) {
+            flush();
+            if(str.length() > _buffer.size()) {
+                write_all(str.data(), str.length());
+                return *this;
+            }
+        }
+        std::memcpy(_buffer.data() + _size, str.data(), str.length());
+        _size += str.length();
+        return *this;
+    }
+
+    output_buffer& operator<<(const char* str) {
+        return *this << std::string_view(str);
+    }
+
+    output_buffer& operator<<(const std::string& str) {
+        return *this << std::string_view(str);
+    }
+
+    output_buffer& operator<<(const char c) {
+        if(_size == _buffer.size()) {
+            flush();
+        }
+        _buffer[_size++] = c;
+        return *this;
+    }
+
+    template <typename T>
+        requires (std::integral<T> && !std::same_as<T,char> && !std::same_as<T,bool>) || std::floating_point<T>
+    output_buffer& operator<<(const T value) {
+        // enough for any integer in base 10, and for the shortest representation of a double
+        constexpr size_t max_length = 32;
+        if(_buffer.size() - _size < max_length) {
+            flush();
+        }
+        char* begin = _buffer.data() + _size;
+        const std::to_chars_result res = std::to_chars(begin, begin + max_length, value);
+        _size += static_cast<size_t>(res.ptr - begin);
+        return *this;
+    }
+
+private:
+    const int _fd;
+    std::vector<char> _buffer;
+    size_t _size = 0;
+
+    void write_all(const char* data, size_t length) const {
+        while(length > 0) {
+            const ssize_t written = ::write(_fd, data, length);
+            if(written < 0) {
+                if(errno == EINTR) {
+                    continue;
+                }
+                throw std::system_error(errno, std::generic_category(), "write");
+            }
+            data += written;
+            length -= static_cast<size_t>(written);
+        }
+    }
+
+};
+
+
+/// @brief the buffer for the standard output, flushed at exit
+/// @note also flushed before terminating on an uncaught exception, which skips the destructors of the static objects,
+///       so that the results printed before the error are not lost
+inline output_buffer& standard_output() {
+    static output_buffer res(STDOUT_FILENO);
+    static const std::terminate_handler previous_handler = std::set_terminate([]() {
+        try {
+            res.flush();
+        } catch(const std::system_error&) {
+            // nowhere left to report it
+        }
+        if(previous_handler != nullptr) {
+            previous_handler();
+        }
+        std::abort();
+    });
+    return res;
+}
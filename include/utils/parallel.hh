@@ -0,0 +1,111 @@
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <omp.h>
+
+
+/*
+ |  Map-reduce over the lines of a buffer, or over the records of a parsed
+ |  input, on the OpenMP thread pool every target is linked with.
+ |
+ |  The work is cut into chunks of a fixed size (newline-aligned for text),
+ |  each chunk is reduced in order by one thread, and the partial results are
+ |  then combined in chunk order. The chunks do not depend on the number of
+ |  threads, so the result is the same whatever the number of threads, even
+ |  for reductions that are not commutative.
+ |
+ |  The number of threads defaults to the OpenMP setting, so that a caller
+ |  that restricted it (the batch runner solving several files at once) is
+ |  respected.
+ */
+
+struct parallel_options {
+    size_t nb_threads = 0;                                // 0 : omp_get_max_threads()
+    size_t chunk_bytes = static_cast<size_t>(64) << 10;   // for text
+    size_t chunk_items = 4096;                            // for records
+};
+
+
+/// @brief cuts the text in consecutive chunks of about `chunk_bytes`, each ending after a newline (but the last one)
+inline std::vector<std::string_view> line_chunks(const std::string_view text, const size_t chunk_bytes) {
+    std::vector<std::string_view> res;
+    size_t begin = 0;
+    while(begin < text.length()) {
+        size_t end = std::min(text.length(), begin + std::max<size_t>(chunk_bytes, 1));
+        if(end < text.length()) {
+            const size_t newline = text.find('\n', end - 1);
+            end = (newline == std::string_view::npos) ? text.length() : (newline + 1);
+        }
+        res.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return res;
+}
+
+
+/// @brief reduces each chunk with `process(chunk, partial)`, then combines the partial results in chunk order
+template <typename T, typename Chunk, typename Process, typename Reduce>
+T reduce_chunks(const std::vector<Chunk>& chunks, const T& identity, Process&& process, Reduce&& reduce, const parallel_options& options) {
+    if(chunks.size() <= 1) {
+        T res = identity;
+        for(const Chunk& chunk: chunks) {
+            process(chunk, res);
+        }
+        return res;
+    }
+
+    const int nb_threads = static_cast<int>((options.nb_threads > 0) ? options.nb_threads : static_cast<size_t>(omp_get_max_threads()));
+    std::vector<T> partials(chunks.size(), identity);
+    #pragma omp parallel for schedule(dynamic) num_threads(nb_threads)
+    for(size_t c = 0; c < chunks.size(); c++) {
+        process(chunks[c], partials[c]);
+    }
+
+    T res = identity;
+    for(T& partial: partials) {
+        res = reduce(std::move(res), std::move(partial));
+    }
+    return res;
+}
+
+
+/// @brief reduce(..., map(line)) over the non-empty lines of the text, in parallel
+template <typename T, typename Map, typename Reduce>
+T map_reduce_lines(const std::string_view text, const T& identity, Map&& map, Reduce&& reduce, const parallel_options& options = {}) {
+    const auto process = [&map, &reduce](const std::string_view chunk, T& acc) {
+        size_t begin = 0;
+        while(begin < chunk.length()) {
+            size_t end = chunk.find('\n', begin);
+            end = (end == std::string_view::npos) ? chunk.length() : end;
+            if(end > begin) {
+                acc = reduce(std::move(acc), map(chunk.substr(begin, end - begin)));
+            }
+            begin = end + 1;
+        }
+    };
+    return reduce_chunks(line_chunks(text, options.chunk_bytes), identity, process, reduce, options);
+}
+
+
+/// @brief reduce(..., map(item)) over the items, in parallel
+template <typename T, typename Item, typename Map, typename Reduce>
+T map_reduce(const std::span<const Item> items, const T& identity, Map&& map, Reduce&& reduce, const parallel_options& options = {}) {
+    std::vector<std::span<const Item>> chunks;
+    const size_t chunk_items = std::max<size_t>(options.chunk_items, 1);
+    for(size_t begin = 0; begin < items.size(); begin += chunk_items) {
+        chunks.push_back(items.subspan(begin, std::min(chunk_items, items.size() - begin)));
+    }
+    const auto process = [&map, &reduce](const std::span<const Item> chunk, T& acc) {
+        for(const Item& item: chunk) {
+            acc = reduce(std::move(acc), map(item));
+        }
+    };
+    return reduce_chunks(chunks, identity, process, reduce, options);
+}
@@ -0,0 +1,387 @@
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <utils/alloc_tracking.hh>
+
+
+/*
+ |  Hardware performance counters around named phases, through perf_event_open.
+ |
+ |  Each counter is opened on its own rather than as a group, so that a counter
+ |  the machine or the hypervisor does not provide only leaves its own column
+ |  empty. Counts are scaled by the time the counter was actually scheduled, in
+ |  case the kernel had to multiplex them. When no counter can be opened at all
+ |  (no PMU, perf_event_paranoid, seccomp), only the wall time is reported.
+ |
+ |  The counters follow the thread that opened them and the threads it starts
+ |  during the phase (inherited counters). By default, the other threads of the
+ |  process are counted as well, so that the OpenMP pool started by an earlier
+ |  phase is included. The batch runner, whose phases run concurrently on their
+ |  own threads, only counts the thread of each phase instead.
+ |
+ |  In the instrumentation build (utils/alloc_tracking.hh), phases also count
+ |  the allocations of their thread and their peak live bytes. A phase marked
+ |  no-alloc that allocates anyway is reported, and fails the run.
+ */
+
+enum class perf_counter { cycles, instructions, cache_misses, branch_misses };
+
+constexpr size_t nb_perf_counters = 4;
+
+using perf_counts = std::array<std::optional<uint64_t>,nb_perf_counters>;
+
+enum class alloc_policy { any, none };
+
+enum class perf_scope {
+    thread,  // the calling thread, and the threads it starts during the phase
+    process  // also the threads already running, e.g. an OpenMP pool
+};
+
+
+/// @brief counters of the calling thread (or of the whole process), opened at construction and read on demand
+class perf_counter_set {
+
+public:
+    explicit perf_counter_set(const perf_scope scope = perf_scope::thread) {
+        std::vector<pid_t> threads = { static_cast<pid_t>(syscall(SYS_gettid)) };
+        if(scope == perf_scope::process) {
+            add_other_threads(threads);
+        }
+        static constexpr std::array<uint64_t,nb_perf_counters> configs = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+        };
+        for(size_t i = 0; i < nb_perf_counters; i++) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            for(const pid_t tid: threads) {
+                const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0));
+                if(fd >= 0) {
+                    _fds[i].push_back(fd);
+                } else if(tid == threads[0]) {
+                    break; // the counter is not available at all
+                }
+            }
+        }
+    }
+
+    perf_counter_set(const perf_counter_set&) = delete;
+    perf_counter_set& operator=(const perf_counter_set&) = delete;
+
+    ~perf_counter_set() {
+        for(const std::vector<int>& fds: _fds) {
+            for(const int fd: fds) {
+                close(fd);
+            }
+        }
+    }
+
+    bool available() const {
+        return std::any_of(_fds.begin(), _fds.end(), [](const std::vector<int>& fds) { return !fds.empty(); });
+    }
+
+    void start() {
+        for(const std::vector<int>& fds: _fds) {
+            for(const int fd: fds) {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    /// @brief the counts summed over the counted threads
+    perf_counts stop() {
+        perf_counts res;
+        for(size_t i = 0; i < nb_perf_counters; i++) {
+            for(const int fd: _fds[i]) {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                uint64_t values[3]; // value, time enabled, time running (including the inherited counters)
+                if(read(fd, values, sizeof(values)) != sizeof(values) || values[2] == 0) {
+                    continue;
+                }
+                const uint64_t count = (values[1] == values[2]) ? values[0]
+                                     : static_cast<uint64_t>(static_cast<double>(values[0]) * static_cast<double>(values[1]) / static_cast<double>(values[2]));
+                res[i] = res[i].value_or(0) + count;
+            }
+        }
+        return res;
+    }
+
+private:
+    std::array<std::vector<int>,nb_perf_counters> _fds;
+
+    static void add_other_threads(std::vector<pid_t>& threads) {
+        DIR* tasks = opendir("/proc/self/task");
+        if(tasks == nullptr) {
+            return;
+        }
+        while(const dirent* entry = readdir(tasks)) {
+            const pid_t tid = static_cast<pid_t>(std::atoi(entry->d_name));
+            if(tid > 0 && tid != threads[0]) {
+                threads.push_back(tid);
+            }
+        }
+        closedir(tasks);
+    }
+
+};
+
+
+/// @brief totals of the phases of a run, grouped by name
+class profiler {
+
+public:
+    /// @brief measures of a single run of a phase
+    struct phase_sample {
+        std::chrono::nanoseconds time;
+        perf_counts counts;
+        uint64_t elements;
+        uint64_t allocations;
+        uint64_t allocated_bytes;
+        int64_t peak_live_bytes; // above the live bytes at the start of the phase
+        alloc_policy policy;
+    };
+
+    struct phase_totals {
+        uint64_t calls = 0;
+        std::chrono::nanoseconds time { 0 };
+        perf_counts counts;
+        uint64_t elements = 0;
+        uint64_t allocations = 0;
+        uint64_t allocated_bytes = 0;
+        int64_t peak_live_bytes = 0;
+        uint64_t no_alloc_violations = 0; // runs of a no-alloc phase that allocated
+    };
+
+    void enable(const perf_scope scope) {
+        _enabled = true;
+        _scope = scope;
+    }
+    bool enabled() const { return _enabled; }
+    perf_scope scope() const { return _scope; }
+
+    void record(const std::string_view name, const phase_sample& sample) {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        phase_totals& totals = _phases[std::string(name)];
+        totals.calls++;
+        totals.time += sample.time;
+        totals.elements += sample.elements;
+        for(size_t i = 0; i < nb_perf_counters; i++) {
+            if(sample.counts[i].has_value()) {
+                totals.counts[i] = totals.counts[i].value_or(0) + sample.counts[i].value();
+            }
+        }
+        totals.allocations += sample.allocations;
+        totals.allocated_bytes += sample.allocated_bytes;
+        totals.peak_live_bytes = std::max(totals.peak_live_bytes, sample.peak_live_bytes);
+        if(sample.policy == alloc_policy::none && sample.allocations > 0) {
+            totals.no_alloc_violations++;
+        }
+    }
+
+    /// @brief whether a phase marked no-alloc allocated, in which case the run should fail
+    bool no_alloc_violated() const {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        return std::any_of(_phases.begin(), _phases.end(), [](const auto& phase) { return phase.second.no_alloc_violations > 0; });
+    }
+
+    void report(std::ostream& out) const {
+        const std::lock_guard<std::mutex> lock(_mutex);
+        out << std::left << std::setw(16) << "phase" << std::right
+            << std::setw(8)  << "calls"
+            << std::setw(12) << "time (ms)"
+            << std::setw(16) << "cycles"
+            << std::setw(16) << "instructions"
+            << std::setw(7)  << "IPC"
+            << std::setw(14) << "cache misses"
+            << std::setw(14) << "branch misses"
+            << std::setw(12) << "elements"
+            << std::setw(13) << "cache m/elt"
+            << std::setw(13) << "branch m/elt";
+        if(alloc_tracking_enabled) {
+            out << std::setw(12) << "allocs" << std::setw(14) << "alloc bytes" << std::setw(14) << "peak live";
+        }
+        out << '\n';
+        bool any_counter = false;
+        for(const auto& [name, totals]: _phases) {
+            const auto cell = [&out](const std::optional<uint64_t>& v, const int width) {
+                if(v.has_value()) {
+                    out << std::setw(width) << v.value();
+                } else {
+                    out << std::setw(width) << '-';
+                }
+            };
+            const auto ratio = [&out](const std::optional<uint64_t>& num, const uint64_t den, const int width, const int precision) {
+                if(num.has_value() && den > 0) {
+                    out << std::setw(width) << std::fixed << std::setprecision(precision) << static_cast<double>(num.value()) / static_cast<double>(den);
+                } else {
+                    out << std::setw(width) << '-';
+                }
+            };
+            const std::optional<uint64_t>& cycles = totals.counts[static_cast<size_t>(perf_counter::cycles)];
+            const std::optional<uint64_t>& instructions = totals.counts[static_cast<size_t>(perf_counter::instructions)];
+            const std::optional<uint64_t>& cache_misses = totals.counts[static_cast<size_t>(perf_counter::cache_misses)];
+            const std::optional<uint64_t>& branch_misses = totals.counts[static_cast<size_t>(perf_counter::branch_misses)];
+            any_counter |= cycles.has_value() || instructions.has_value() || cache_misses.has_value() || branch_misses.has_value();
+
+            out << std::left << std::setw(16) << name << std::right << std::setw(8) << totals.calls
+                << std::setw(12) << std::fixed << std::setprecision(3) << static_cast<double>(totals.time.count()) / 1e6;
+            cell(cycles, 16);
+            cell(instructions, 16);
+            ratio(instructions, cycles.value_or(0), 7, 2);
+            cell(cache_misses, 14);
+            cell(branch_misses, 14);
+            out << std::setw(12) << totals.elements;
+            ratio(cache_misses, totals.elements, 13, 4);
+            ratio(branch_misses, totals.elements, 13, 4);
+            if(alloc_tracking_enabled) {
+                out << std::setw(12) << totals.allocations << std::setw(14) << totals.allocated_bytes << std::setw(14) << totals.peak_live_bytes;
+            }
+            out << '\n';
+        }
+        if(!any_counter) {
+            out << "(hardware counters unavailable, only the wall time was measured)\n";
+        }
+        if(const std::optional<uint64_t> rss = peak_rss_bytes(); rss.has_value()) {
+            out << "peak RSS : " << rss.value() << " bytes\n";
+        }
+        for(const auto& [name, totals]: _phases) {
+            if(totals.no_alloc_violations > 0) {
+                out << "error : the no-alloc phase '" << name << "' allocated in " << totals.no_alloc_violations
+                    << " of its " << totals.calls << " runs\n";
+            }
+        }
+    }
+
+private:
+    bool _enabled = false;
+    perf_scope _scope = perf_scope::process;
+    mutable std::mutex _mutex;
+    std::map<std::string,phase_totals> _phases;
+
+};
+
+inline profiler& global_profiler() {
+    static profiler res;
+    return res;
+}
+
+
+/// @brief measures the enclosing scope as a phase of the global profiler, if it is enabled
+class perf_phase {
+
+public:
+    explicit perf_phase(const std::string_view name, const uint64_t elements = 0, const alloc_policy policy = alloc_policy::any):
+        _name(name), _elements(elements), _policy(policy) {
+        if(global_profiler().enabled()) {
+            // opening the counters allocates, before the phase starts
+            _counters.emplace(global_profiler().scope());
+            // the peak is reset to the current live bytes for the phase, and merged back at its end for enclosing phases
+            alloc_counters& allocs = thread_alloc_counters();
+            _allocs_start = allocs;
+            allocs.peak = allocs.live;
+            _counters->start();
+            _start = std::chrono::steady_clock::now();
+        }
+    }
+
+    perf_phase(const perf_phase&) = delete;
+    perf_phase& operator=(const perf_phase&) = delete;
+
+    ~perf_phase() {
+        if(_counters.has_value()) {
+            const perf_counts counts = _counters->stop();
+            const std::chrono::nanoseconds time = std::chrono::steady_clock::now() - _start;
+            alloc_counters& allocs = thread_alloc_counters();
+            const alloc_counters allocs_end = allocs;
+            global_profiler().record(_name, {
+                time, counts, _elements,
+                allocs_end.allocations - _allocs_start.allocations,
+                allocs_end.bytes - _allocs_start.bytes,
+                allocs_end.peak - _allocs_start.live,
+                _policy
+            });
+            allocs = allocs_end; // the bookkeeping of the profiler is not charged to the enclosing phases
+            allocs.peak = std::max(_allocs_start.peak, allocs_end.peak);
+        }
+    }
+
+    /// @brief for phases that only know their number of elements once they have run
+    void set_elements(const uint64_t elements) { _elements = elements; }
+
+private:
+    const std::string_view _name;
+    uint64_t _elements;
+    const alloc_policy _policy;
+    alloc_counters _allocs_start;
+    std::optional<perf_counter_set> _counters;
+    std::chrono::steady_clock::time_point _start;
+
+};
+
+
+/// @brief runs the function as a phase of the global profiler and returns its result
+template <typename F>
+auto measured(const std::string_view name, const uint64_t elements, F&& f) {
+    const perf_phase phase(name, elements);
+    return f();
+}
+
+/// @brief same as measured, for a phase that must not allocate
+template <typename F>
+auto measured_no_alloc(const std::string_view name, const uint64_t elements, F&& f) {
+    const perf_phase phase(name, elements, alloc_policy::none);
+    return f();
+}
+
+
+/// @brief enables the global profiler if requested, and prints its report on the error output at the end of the scope
+class perf_report_scope {
+
+public:
+    explicit perf_report_scope(const bool enable, const perf_scope scope = perf_scope::process) {
+        if(enable) {
+            global_profiler().enable(scope);
+        }
+    }
+
+    perf_report_scope(const perf_report_scope&) = delete;
+    perf_report_scope& operator=(const perf_report_scope&) = delete;
+
+    ~perf_report_scope() {
+        if(global_profiler().enabled()) {
+            global_profiler().report(std::cerr);
+        }
+    }
+
+};
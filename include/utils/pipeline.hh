@@ -0,0 +1,239 @@
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include <utils/decompress.hh>
+
+
+/// @brief lock-free bounded queue between exactly one producer thread and one consumer thread
+template <typename T, size_t Capacity>
+class spsc_ring {
+
+    static_assert((Capacity & (Capacity - 1)) == 0, "the capacity must be a power of two");
+
+public:
+    /// @note the value is only moved from if it was pushed
+    bool try_push(T&& value) {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if(tail - _head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        _slots[tail & (Capacity - 1)] = std::move(value);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if(head == _tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(_slots[head & (Capacity - 1)]);
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    // head and tail on separate cache lines, so that the two threads do not invalidate each other's line
+    alignas(64) std::atomic<size_t> _head = 0;
+    alignas(64) std::atomic<size_t> _tail = 0;
+    std::array<T,Capacity> _slots;
+
+};
+
+
+/// @brief block of input that only contains complete lines
+struct line_batch {
+    std::vector<char> buffer; // recycled from batch to batch, only grows for lines longer than a block
+    size_t length = 0;
+    bool end = false;         // no more input after this batch
+
+    std::string_view lines() const { return std::string_view(buffer.data(), length); }
+};
+
+
+/*
+ |  The reader thread fills blocks from the input and hands them to the
+ |  solver thread once they have been cut after their last newline. The partial
+ |  line at the end of a block is carried over to the start of the next one.
+ |
+ |  A fixed set of buffers circulates between the two threads through two rings :
+ |  full batches go from the reader to the solver, consumed ones come back, so
+ |  that reading the next blocks overlaps with processing the current one and no
+ |  memory is allocated once the buffers have reached their size.
+ |
+ |  A thread that finds its ring empty (or full) spins briefly, then sleeps on
+ |  a counter that the other thread bumps after each push and pop, so that a
+ |  slow input does not keep a core busy while the reader is blocked in read(2).
+ |
+ |  Compressed input is decompressed by the reader thread as well.
+ */
+class line_pipeline {
+
+public:
+    static constexpr size_t block_size = static_cast<size_t>(1) << 20;
+    static constexpr size_t nb_buffers = 4;
+    static constexpr size_t spin_limit = 64; // yields before sleeping
+
+    explicit line_pipeline(input_source& source): _source(source) {
+        for(size_t i = 0; i < nb_buffers; i++) {
+            line_batch batch;
+            batch.buffer.resize(block_size);
+            _free.try_push(std::move(batch));
+        }
+        _reader = std::thread([this]() { read_batches(); });
+    }
+
+    line_pipeline(const line_pipeline&) = delete;
+    line_pipeline& operator=(const line_pipeline&) = delete;
+
+    /// @note the pipeline may be destroyed before the last batch, e.g. when processing a batch threw :
+    ///       the reader is then stopped, even while waiting for input, and the rest of the input is left unread
+    ~line_pipeline() {
+        _stop.store(true, std::memory_order_relaxed);
+        signal();
+        _source.request_stop();
+        _reader.join();
+    }
+
+    /// @brief waits for the next batch, the last one has `end` set
+    /// @note rethrows the error that stopped the reader, if any, instead of returning the last batch
+    line_batch next() {
+        line_batch res;
+        wait_until([this, &res]() { return _full.try_pop(res); });
+        signal();
+        if(res.end && _error) {
+            std::rethrow_exception(_error);
+        }
+        return res;
+    }
+
+    /// @brief gives a consumed batch back to the reader
+    void recycle(line_batch&& batch) {
+        wait_until([this, &batch]() { return _free.try_push(std::move(batch)); });
+        signal();
+    }
+
+private:
+    input_source& _source;
+    std::atomic<bool> _stop = false;
+    std::atomic<uint32_t> _progress = 0; // bumped after each push and pop, and when stopping
+    std::exception_ptr _error;
+    spsc_ring<line_batch,nb_buffers> _full;
+    spsc_ring<line_batch,nb_buffers> _free;
+    std::thread _reader;
+
+    void signal() {
+        _progress.fetch_add(1, std::memory_order_release);
+        _progress.notify_one();
+    }
+
+    /// @brief retries the operation on a ring until it succeeds, or until the pipeline is stopped
+    /// @note the counter is read before each attempt, so a push or pop between a failed attempt and the wait is not missed
+    template <typename Op>
+    bool wait_until(Op&& op) {
+        for(size_t spins = 0;; spins++) {
+            const uint32_t progress = _progress.load(std::memory_order_acquire);
+            if(op()) {
+                return true;
+            }
+            if(_stop.load(std::memory_order_relaxed)) {
+                return false;
+            }
+            if(spins < spin_limit) {
+                std::this_thread::yield();
+            } else {
+                _progress.wait(progress, std::memory_order_acquire);
+            }
+        }
+    }
+
+    void read_batches() {
+        std::vector<char> carry;
+        bool eof = false;
+        while(!eof) {
+            line_batch batch;
+            if(!wait_until([this, &batch]() { return _free.try_pop(batch); })) {
+                return;
+            }
+            signal();
+
+            std::vector<char>& buffer = batch.buffer;
+            buffer.resize(std::max(buffer.size(), 2 * carry.size()));
+            std::copy(carry.begin(), carry.end(), buffer.begin());
+            size_t filled = carry.size();
+            size_t last_newline = std::string_view::npos;
+            while(!eof && (filled < buffer.size() || last_newline == std::string_view::npos)) {
+                if(filled == buffer.size()) {
+                    buffer.resize(2 * buffer.size()); // a line does not fit in the buffer
+                }
+                size_t nb_read = 0;
+                try {
+                    nb_read = _source.read(buffer.data() + filled, buffer.size() - filled);
+                } catch(...) {
+                    _error = std::current_exception(); // rethrown on the solver thread with the last batch
+                }
+                if(nb_read == 0) {
+                    eof = true;
+                    break;
+                }
+                const std::string_view chunk(buffer.data() + filled, nb_read);
+                const size_t pos = chunk.rfind('\n');
+                if(pos != std::string_view::npos) {
+                    last_newline = filled + pos;
+                }
+                filled += nb_read;
+            }
+
+            batch.length = (eof || last_newline == std::string_view::npos) ? filled : (last_newline + 1);
+            batch.end = eof;
+            carry.assign(buffer.begin() + batch.length, buffer.begin() + filled);
+
+            if(!wait_until([this, &batch]() { return _full.try_push(std::move(batch)); })) {
+                return;
+            }
+            signal();
+        }
+    }
+
+};
+
+
+/// @brief calls the function on successive views of complete lines, while the next ones are being read
+template <typename F>
+void for_each_line_batch(F&& process, input_source& source) {
+    line_pipeline pipeline(source);
+    bool end = false;
+    while(!end) {
+        line_batch batch = pipeline.next();
+        process(batch.lines());
+        end = batch.end;
+        pipeline.recycle(std::move(batch));
+    }
+}
+
+template <typename F>
+void for_each_line_batch(F&& process, const int fd = STDIN_FILENO) {
+    input_source source(fd);
+    for_each_line_batch(std::forward<F>(process), source);
+}
+
+/// @brief builds parsed input batch by batch, with a function appending the records of complete lines
+template <typename Parsed, typename ParseLines>
+Parsed parse_pipelined(ParseLines&& parse_lines, const int fd = STDIN_FILENO) {
+    Parsed res;
+    for_each_line_batch([&res, &parse_lines](const std::string_view lines) { parse_lines(res, lines); }, fd);
+    return res;
+}
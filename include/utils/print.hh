@@ -4,9 +4,11 @@
 #include <iostream>
 #include <vector>
 
+#include <utils/output.hh>
 
-template <typename T>
-std::ostream& operator<<(std::ostream& os, const std::vector<T>& list) {
+
+template <typename Out, typename T>
+Out& print_list(Out& os, const std::vector<T>& list) {
     os << '[';
     auto it = list.begin();
     if(it != list.end()) {
@@ -20,3 +22,13 @@ std::ostream& operator<<(std::ostream& os, const std::vector<T>& list) {
     os << ']';
     return os;
 }
+
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const std::vector<T>& list) {
+    return print_list(os, list);
+}
+
+template <typename T>
+output_buffer& operator<<(output_buffer& out, const std::vector<T>& list) {
+    return print_list(out, list);
+}
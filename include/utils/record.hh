@@ -0,0 +1,170 @@
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <utils/split.hh>
+
+
+/*
+ |  Records parsed according to a pattern known at compile time, in which each
+ |  "{}" stands for a field, e.g. "Game {}: {}" or "{} = ({}, {})".
+ |
+ |  The pattern is cut into its literal parts by the compiler, and the parser
+ |  generated for it reads the line once from left to right : literals are
+ |  compared in place, numbers are converted as their digits are read, text
+ |  fields are views on the line that end where the next literal starts. No
+ |  iterator nor string is created on the way.
+ |
+ |  Fields are unsigned or signed integers, which skip the spaces before them
+ |  (to allow for aligned columns such as "Card   1"), or std::string_view.
+ */
+
+template <fixed_string Pattern>
+struct record_pattern {
+
+    static constexpr std::string_view placeholder = "{}";
+
+    static constexpr size_t nb_fields = []() {
+        size_t res = 0;
+        for(size_t pos = Pattern.view().find(placeholder); pos != std::string_view::npos; pos = Pattern.view().find(placeholder, pos + placeholder.length())) {
+            res++;
+        }
+        return res;
+    }();
+
+    /// @brief the literal before each field, then the one after the last field (possibly empty)
+    static constexpr std::array<std::string_view,nb_fields+1> literals = []() {
+        std::array<std::string_view,nb_fields+1> res;
+        size_t begin = 0;
+        for(size_t i = 0; i < nb_fields; i++) {
+            const size_t pos = Pattern.view().find(placeholder, begin);
+            res[i] = Pattern.view().substr(begin, pos - begin);
+            begin = pos + placeholder.length();
+        }
+        res[nb_fields] = Pattern.view().substr(begin);
+        return res;
+    }();
+
+    static_assert([]() {
+        for(size_t i = 1; i < nb_fields; i++) {
+            if(literals[i].empty()) {
+                return false;
+            }
+        }
+        return true;
+    }(), "consecutive fields must be separated by a literal");
+
+};
+
+
+namespace record_detail {
+
+constexpr bool match_literal(const std::string_view line, size_t& pos, const std::string_view literal) {
+    if(line.substr(pos, literal.length()) != literal) {
+        return false;
+    }
+    pos += literal.length();
+    return true;
+}
+
+template <typename T>
+constexpr bool read_field(const std::string_view line, size_t& pos, T& field, const std::string_view next_literal) {
+    if constexpr(std::is_same_v<T, std::string_view>) {
+        if(next_literal.empty()) {
+            field = line.substr(pos);
+            pos = line.length();
+            return true;
+        }
+        const size_t end = (next_literal.length() == 1) ? line.find(next_literal[0], pos) : line.find(next_literal, pos);
+        if(end == std::string_view::npos) {
+            return false;
+        }
+        field = line.substr(pos, end - pos);
+        pos = end;
+        return true;
+    } else {
+        static_assert(std::is_integral_v<T>, "record fields are integers or std::string_view");
+        while(pos < line.length() && line[pos] == ' ') {
+            pos++;
+        }
+        bool negative = false;
+        if constexpr(std::is_signed_v<T>) {
+            if(pos < line.length() && line[pos] == '-') {
+                negative = true;
+                pos++;
+            }
+        }
+        const size_t begin = pos;
+        T value = 0;
+        for(; pos < line.length() && line[pos] >= '0' && line[pos] <= '9'; pos++) {
+            // negative values are accumulated below zero, so that the minimum of the type can be read
+            const T digit = static_cast<T>(line[pos] - '0');
+            if(__builtin_mul_overflow(value, 10, &value)
+               || (negative ? __builtin_sub_overflow(value, digit, &value) : __builtin_add_overflow(value, digit, &value))) {
+                return false; // the value does not fit in the field
+            }
+        }
+        field = value;
+        return pos > begin;
+    }
+}
+
+}
+
+
+/// @brief the fields of a line following the pattern, or nullopt if it does not
+/// @note e.g. `parse_record<"Game {}: {}", uint32_t, std::string_view>("Game 7: 3 blue")`
+template <fixed_string Pattern, typename... Fields>
+constexpr std::optional<std::tuple<Fields...>> parse_record(const std::string_view line) {
+    using pattern = record_pattern<Pattern>;
+    static_assert(pattern::nb_fields == sizeof...(Fields), "one type must be given per field of the pattern");
+
+    std::tuple<Fields...> res;
+    size_t pos = 0;
+    bool matched = record_detail::match_literal(line, pos, pattern::literals[0]);
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        ((matched = matched
+                 && record_detail::read_field(line, pos, std::get<I>(res), pattern::literals[I+1])
+                 && record_detail::match_literal(line, pos, pattern::literals[I+1])), ...);
+    }(std::index_sequence_for<Fields...>());
+
+    if(!matched || pos != line.length()) {
+        return std::nullopt;
+    }
+    return res;
+}
+
+/*
+ |  Checks evaluated by the compiler
+ */
+
+static_assert(parse_record<"Card {}: {} | {}", uint32_t, std::string_view, std::string_view>("Card   3: 1 21 | 21 72")
+              == std::tuple<uint32_t, std::string_view, std::string_view>(3, "1 21", "21 72"));
+static_assert(parse_record<"{} = ({}, {})", std::string_view, std::string_view, std::string_view>("AAA = (BBB, CCC)")
+              == std::tuple<std::string_view, std::string_view, std::string_view>("AAA", "BBB", "CCC"));
+static_assert(!parse_record<"Game {}: {}", uint32_t, std::string_view>("Game : 3 blue").has_value());
+static_assert(!parse_record<"{} {}", int32_t, uint32_t>("-4 5 6").has_value());
+static_assert(parse_record<"{} {}", int8_t, uint8_t>("-128 255") == std::tuple<int8_t, uint8_t>(-128, 255));
+static_assert(!parse_record<"{}", int8_t>("128").has_value());
+static_assert(!parse_record<"{}", uint32_t>("4294967296").has_value());
+
+
+/// @brief same as parse_record, for lines that must follow the pattern
+template <fixed_string Pattern, typename... Fields>
+std::tuple<Fields...> read_record(const std::string_view line) {
+    std::optional<std::tuple<Fields...>> res = parse_record<Pattern, Fields...>(line);
+    if(!res.has_value()) {
+        throw std::runtime_error("the line \"" + std::string(line) + "\" does not follow \"" + std::string(Pattern.view()) + "\"");
+    }
+    return std::move(res.value());
+}
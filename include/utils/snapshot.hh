@@ -0,0 +1,226 @@
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+/*
+ |  Binary snapshots of parsed inputs, so that inputs solved again and again are
+ |  only parsed once.
+ |
+ |  A snapshot is a header followed by a table of sections, each section being
+ |  an array of trivially copyable records. Sections are located by their offset
+ |  from the start of the file (no pointers are stored) and aligned on cache
+ |  lines, so that a mapped snapshot can be read in place.
+ |
+ |  The header records the day and the version of the day's layout : a snapshot
+ |  written by another day or by an older layout is rejected instead of being
+ |  misread. Records are stored in the byte order of the machine, which is
+ |  checked as well.
+ */
+
+namespace snapshot_format {
+
+constexpr uint32_t version = 1;
+constexpr uint32_t byte_order_mark = 0x01020304;
+constexpr size_t alignment = 64;
+
+struct header {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t day;
+    uint32_t layout_version; // bumped by a day whenever the records it writes change
+    uint64_t nb_sections;
+};
+
+struct section_entry {
+    uint64_t offset;
+    uint64_t count;
+    uint64_t element_size;
+};
+
+constexpr char magic[8] = { 'A', 'O', 'C', 'S', 'N', 'A', 'P', '\0' };
+
+}
+
+
+class snapshot_writer {
+
+public:
+    snapshot_writer(const uint32_t day, const uint32_t layout_version): _day(day), _layout_version(layout_version) {}
+
+    template <typename T>
+    void add(const std::span<const T> values) {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshot records must be trivially copyable");
+        std::vector<char> bytes(values.size_bytes());
+        if(!values.empty()) {
+            std::memcpy(bytes.data(), values.data(), values.size_bytes());
+        }
+        _sections.push_back({ values.size(), sizeof(T), std::move(bytes) });
+    }
+
+    template <typename T>
+    void add_value(const T& value) {
+        add(std::span<const T>(&value, 1));
+    }
+
+    void write(const std::filesystem::path& path) const {
+        using namespace snapshot_format;
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if(!out) {
+            throw std::runtime_error("cannot write the snapshot " + path.string());
+        }
+
+        header h {};
+        std::memcpy(h.magic, magic, sizeof(magic));
+        h.version = version;
+        h.byte_order = byte_order_mark;
+        h.day = _day;
+        h.layout_version = _layout_version;
+        h.nb_sections = _sections.size();
+
+        std::vector<section_entry> table;
+        uint64_t offset = aligned(sizeof(header) + _sections.size() * sizeof(section_entry));
+        for(const section& s: _sections) {
+            table.push_back({ offset, s.count, s.element_size });
+            offset = aligned(offset + s.bytes.size());
+        }
+
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(section_entry));
+        uint64_t position = sizeof(header) + table.size() * sizeof(section_entry);
+        for(size_t i = 0; i < _sections.size(); i++) {
+            pad(out, table[i].offset - position);
+            out.write(_sections[i].bytes.data(), _sections[i].bytes.size());
+            position = table[i].offset + _sections[i].bytes.size();
+        }
+        if(!out) {
+            throw std::runtime_error("cannot write the snapshot " + path.string());
+        }
+    }
+
+private:
+    struct section {
+        uint64_t count;
+        uint64_t element_size;
+        std::vector<char> bytes;
+    };
+
+    const uint32_t _day;
+    const uint32_t _layout_version;
+    std::vector<section> _sections;
+
+    static uint64_t aligned(const uint64_t offset) {
+        return (offset + snapshot_format::alignment - 1) & ~static_cast<uint64_t>(snapshot_format::alignment - 1);
+    }
+
+    static void pad(std::ofstream& out, const uint64_t nb_bytes) {
+        static constexpr char zeros[snapshot_format::alignment] = {};
+        out.write(zeros, static_cast<std::streamsize>(nb_bytes));
+    }
+
+};
+
+
+/// @brief read-only mapping of a snapshot, whose sections are viewed in place
+class snapshot {
+
+public:
+    snapshot(const std::filesystem::path& path, const uint32_t day, const uint32_t layout_version) {
+        using namespace snapshot_format;
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) {
+            throw std::runtime_error("cannot open the snapshot " + path.string());
+        }
+        struct stat st {};
+        if(::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(header)) {
+            ::close(fd);
+            throw std::runtime_error("invalid snapshot " + path.string());
+        }
+        _size = static_cast<size_t>(st.st_size);
+        void* data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // the mapping stays valid
+        if(data == MAP_FAILED) {
+            throw std::runtime_error("cannot map the snapshot " + path.string());
+        }
+        _data = static_cast<const char*>(data);
+
+        const header& h = *reinterpret_cast<const header*>(_data);
+        if(std::memcmp(h.magic, magic, sizeof(magic)) != 0 || h.version != version || h.byte_order != byte_order_mark) {
+            release();
+            throw std::runtime_error("not a snapshot of this format : " + path.string());
+        }
+        if(h.day != day || h.layout_version != layout_version) {
+            release();
+            throw std::runtime_error("the snapshot " + path.string() + " was written for another day or layout");
+        }
+        if(sizeof(header) + h.nb_sections * sizeof(section_entry) > _size) {
+            release();
+            throw std::runtime_error("truncated snapshot " + path.string());
+        }
+        _sections = std::span<const section_entry>(reinterpret_cast<const section_entry*>(_data + sizeof(header)), h.nb_sections);
+        for(const section_entry& s: _sections) {
+            if(s.offset % alignment != 0 || s.offset > _size || s.count * s.element_size > _size - s.offset) {
+                release();
+                throw std::runtime_error("truncated snapshot " + path.string());
+            }
+        }
+    }
+
+    snapshot(const snapshot&) = delete;
+    snapshot& operator=(const snapshot&) = delete;
+
+    ~snapshot() {
+        release();
+    }
+
+    size_t nb_sections() const { return _sections.size(); }
+
+    /// @brief the records of a section, read from the mapping without any copy
+    template <typename T>
+    std::span<const T> section(const size_t i) const {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshot records must be trivially copyable");
+        if(i >= _sections.size() || _sections[i].element_size != sizeof(T)) {
+            throw std::runtime_error("unexpected section in the snapshot");
+        }
+        return std::span<const T>(reinterpret_cast<const T*>(_data + _sections[i].offset), _sections[i].count);
+    }
+
+    template <typename T>
+    const T& value(const size_t i) const {
+        const std::span<const T> res = section<T>(i);
+        if(res.size() != 1) {
+            throw std::runtime_error("unexpected section in the snapshot");
+        }
+        return res[0];
+    }
+
+private:
+    const char* _data = nullptr;
+    size_t _size = 0;
+    std::span<const snapshot_format::section_entry> _sections;
+
+    void release() {
+        if(_data != nullptr) {
+            ::munmap(const_cast<char*>(_data), _size);
+            _data = nullptr;
+        }
+    }
+
+};
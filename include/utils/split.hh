@@ -1,21 +1,24 @@
 
 #pragma once
 
-#include <string>
+#include <algorithm>
+#include <cstddef>
+#include <string_view>
+#include <utility>
 
 
 class split {
 
 public:
-    split(const std::string_view& view, const std::string& sep): _view(view), _separator(sep) {}
+    constexpr split(const std::string_view view, const std::string_view sep): _view(view), _separator(sep) {}
 
     class iterator {
 
     public:
-        static iterator make_begin(std::string_view view, std::string_view sep) { return iterator(view, sep, 0);           }
-        static iterator make_end(std::string_view view, std::string_view sep)   { return iterator(view, sep, view.size()); }
+        static constexpr iterator make_begin(std::string_view view, std::string_view sep) { return iterator(view, sep, 0);           }
+        static constexpr iterator make_end(std::string_view view, std::string_view sep)   { return iterator(view, sep, view.size()); }
 
-        iterator& operator++() { 
+        constexpr iterator& operator++() { 
             _begin = _end + _sep.size();
             if(_begin > _view.size()) {
                 _begin = _view.size();
@@ -23,17 +26,17 @@ public:
             _end = next_pos(_view, _sep, _begin);
             return *this;
         }
-        iterator operator++(int) { iterator res = *this; ++(*this); return res; }
+        constexpr iterator operator++(int) { iterator res = *this; ++(*this); return res; }
 
-        bool operator==(const iterator& it) const { 
+        constexpr bool operator==(const iterator& it) const { 
             return _view.data() == it._view.data() 
                 && _sep.data()  == it._sep.data()
                 && _begin       == it._begin
                 && _end         == it._end;
         }
-        bool operator!=(const iterator& it) const { return !(*this == it); }
+        constexpr bool operator!=(const iterator& it) const { return !(*this == it); }
 
-        std::string_view operator*() { return _view.substr(_begin, _end - _begin); }
+        constexpr std::string_view operator*() const { return _view.substr(_begin, _end - _begin); }
 
         // iterator traits
         using difference_type = std::ptrdiff_t;
@@ -44,8 +47,8 @@ public:
 
     protected:
         // End
-        iterator(std::string_view view, std::string_view sep): _view(view), _sep(sep), _begin(view.size()), _end(view.size()) {}
-        iterator(std::string_view view, std::string_view sep, std::size_t pos): _view(view), _sep(sep), _begin(pos), _end(next_pos(_view, _sep, _begin)) {}
+        constexpr iterator(std::string_view view, std::string_view sep): _view(view), _sep(sep), _begin(view.size()), _end(view.size()) {}
+        constexpr iterator(std::string_view view, std::string_view sep, std::size_t pos): _view(view), _sep(sep), _begin(pos), _end(next_pos(_view, _sep, _begin)) {}
 
     private:
         const std::string_view _view;
@@ -53,7 +56,7 @@ public:
         std::size_t _begin;
         std::size_t _end;
 
-        static std::size_t next_pos(std::string_view view, std::string_view sep, std::size_t pos) {
+        static constexpr std::size_t next_pos(std::string_view view, std::string_view sep, std::size_t pos) {
             if(pos >= view.size()) {
                 return view.size();
             }
@@ -63,17 +66,17 @@ public:
 
     };
 
-    iterator begin() { return iterator::make_begin(_view, _separator); }
-    iterator end()   { return iterator::make_end(_view, _separator);   }
+    constexpr iterator begin() const { return iterator::make_begin(_view, _separator); }
+    constexpr iterator end()   const { return iterator::make_end(_view, _separator);   }
 
 private:
     std::string_view _view;
-    std::string _separator;
+    std::string_view _separator; // separators are expected to be literals
 
 };
 
 
-std::pair<std::string_view, std::string_view> split_once(const std::string_view str, const std::string_view sep) {
+constexpr std::pair<std::string_view, std::string_view> split_once(const std::string_view str, const std::string_view sep) {
     std::size_t pos = str.find(sep);
     if(pos == std::string_view::npos) {
         return { str, std::string_view() };
@@ -81,3 +84,34 @@ std::pair<std::string_view, std::string_view> split_once(const std::string_view
     return { str.substr(0, pos), str.substr(pos + sep.length()) };
 }
 
+
+
+/// @brief string literal usable as a template argument, to give separators at compile time
+template <std::size_t N>
+struct fixed_string {
+    constexpr fixed_string(const char (&str)[N]) { std::copy_n(str, N, value); }
+
+    constexpr std::string_view view() const { return std::string_view(value, N - 1); }
+
+    char value[N];
+};
+
+
+/// @brief `split` with a separator known at compile time, e.g. `split_on<"\n">(input)`
+template <fixed_string Sep>
+constexpr split split_on(const std::string_view str) {
+    static_assert(Sep.view().length() > 0, "the separator must not be empty");
+    return split(str, Sep.view());
+}
+
+/// @brief `split_once` with a separator known at compile time, single characters are searched as such
+template <fixed_string Sep>
+constexpr std::pair<std::string_view, std::string_view> split_once(const std::string_view str) {
+    constexpr std::string_view sep = Sep.view();
+    static_assert(sep.length() > 0, "the separator must not be empty");
+    const std::size_t pos = (sep.length() == 1) ? str.find(sep[0]) : str.find(sep);
+    if(pos == std::string_view::npos) {
+        return { str, std::string_view() };
+    }
+    return { str.substr(0, pos), str.substr(pos + sep.length()) };
+}
@@ -0,0 +1,149 @@
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <omp.h>
+
+#include <days/registry.hh>
+#include <utils/args.hh>
+#include <utils/input.hh>
+#include <utils/json.hh>
+#include <utils/output.hh>
+#include <utils/perf.hh>
+
+
+/*------------------------------------------------------------------------------------------------------------+
+|                                                  Solving                                                    |
++------------------------------------------------------------------------------------------------------------*/
+
+struct batch_result {
+    std::optional<std::string> answer;
+    std::string error;
+};
+
+batch_result solve_file(const day_solver& solver, const std::filesystem::path& path, const bool part2) {
+    try {
+        const std::optional<std::string> input = read_file(path);
+        if(!input.has_value()) {
+            return { std::nullopt, "cannot read file" };
+        }
+        return { solver.solve(input.value(), part2), "" };
+    } catch(const std::exception& e) {
+        return { std::nullopt, e.what() };
+    }
+}
+
+/// @brief solves all the files on a fixed pool of threads, each thread taking the next unsolved file
+/// @note the solvers' own OpenMP regions are restricted to one thread inside the workers,
+///       the parallelism comes from solving several files at once
+std::vector<batch_result> solve_all(const day_solver& solver, const std::vector<std::filesystem::path>& inputs, const bool part2, const uint32_t nb_threads) {
+    std::vector<batch_result> results(inputs.size());
+    std::atomic<size_t> next = 0;
+
+    const auto worker = [&]() {
+        omp_set_num_threads(1);
+        for(size_t i = next++; i < inputs.size(); i = next++) {
+            results[i] = solve_file(solver, inputs[i], part2);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for(uint32_t t = 0; t < nb_threads; t++) {
+        pool.emplace_back(worker);
+    }
+    for(std::thread& thread: pool) {
+        thread.join();
+    }
+    return results;
+}
+
+
+/*------------------------------------------------------------------------------------------------------------+
+|                                                  Output                                                     |
++------------------------------------------------------------------------------------------------------------*/
+
+void write_json(output_buffer& out, const std::vector<std::filesystem::path>& inputs, const std::vector<batch_result>& results) {
+    out << "[\n";
+    for(size_t i = 0; i < inputs.size(); i++) {
+        out << "  { \"file\": ";
+        write_json_string(out, inputs[i].string());
+        out << ", \"answer\": ";
+        if(results[i].answer.has_value()) {
+            write_json_string(out, results[i].answer.value());
+        } else {
+            out << "null";
+        }
+        if(!results[i].error.empty()) {
+            out << ", \"error\": ";
+            write_json_string(out, results[i].error);
+        }
+        out << " }" << (i + 1 < inputs.size() ? "," : "") << '\n';
+    }
+    out << "]\n";
+}
+
+/// @brief one line per file: path, answer (empty when there is none), error (empty on success)
+void write_tsv(output_buffer& out, const std::vector<std::filesystem::path>& inputs, const std::vector<batch_result>& results) {
+    for(size_t i = 0; i < inputs.size(); i++) {
+        out << inputs[i].string() << '\t' << results[i].answer.value_or("") << '\t' << results[i].error << '\n';
+    }
+}
+
+
+/*------------------------------------------------------------------------------------------------------------+
+|                                                  Main                                                       |
++------------------------------------------------------------------------------------------------------------*/
+
+int main(int argc, char** argv) {
+
+    std::ios::sync_with_stdio(false);
+
+    const std::vector<std::string_view> args = positional_arguments(argc, argv, { "--threads" });
+    if(args.size() < 2) {
+        std::cerr << "usage: " << argv[0] << " <day> [--part2] [--json] [--perf] [--threads N] <directory or file>..." << std::endl;
+        return 2;
+    }
+
+    const day_solver* solver = find_day(args[0]);
+    if(solver == nullptr) {
+        std::cerr << "unknown day : " << args[0] << std::endl;
+        return 2;
+    }
+
+    uint32_t nb_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    if(const std::optional<std::string_view> threads = flag_value(argc, argv, "--threads"); threads.has_value()) {
+        const auto [ptr, ec] = std::from_chars(threads->data(), threads->data() + threads->length(), nb_threads);
+        if(ec != std::errc() || ptr != threads->data() + threads->length() || nb_threads == 0) {
+            std::cerr << "invalid number of threads : " << threads.value() << std::endl;
+            return 2;
+        }
+    }
+
+    const std::vector<std::filesystem::path> inputs = list_inputs(std::span(args).subspan(1));
+    std::vector<batch_result> results;
+    {
+        // the files are solved concurrently, each phase only counts the thread solving it
+        const perf_report_scope perf_report(has_flag(argc, argv, "--perf"), perf_scope::thread);
+        results = solve_all(*solver, inputs, has_flag(argc, argv, "--part2"), nb_threads);
+    }
+
+    if(has_flag(argc, argv, "--json")) {
+        write_json(standard_output(), inputs, results);
+    } else {
+        write_tsv(standard_output(), inputs, results);
+    }
+
+    const bool all_solved = std::all_of(results.begin(), results.end(), [](const batch_result& r) { return r.error.empty(); });
+    return (all_solved && !global_profiler().no_alloc_violated()) ? 0 : 1;
+}
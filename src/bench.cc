@@ -0,0 +1,348 @@
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <days/registry.hh>
+#include <utils/args.hh>
+#include <utils/input.hh>
+#include <utils/json.hh>
+
+
+// set by meson to the buildtype of the build directory (debug, debugoptimized, release, ...)
+#ifndef AOC_BUILD_TYPE
+#define AOC_BUILD_TYPE "unknown"
+#endif
+
+
+/*
+ |  Benchmark baselines and regression detection.
+ |
+ |  `record` solves each input a number of times and stores the samples in a
+ |  JSON baseline, keyed by day, part, input and build type. `compare` takes new
+ |  samples and compares them with the baseline entry of the same key, so that
+ |  a debug build is never compared with a release one.
+ |
+ |  A change is significant when the 95% confidence interval of the difference
+ |  of the means (Welch's t interval, the variances of the two runs need not be
+ |  equal) excludes zero. The run fails when a significant slowdown exceeds the
+ |  threshold, relative to the baseline mean.
+ */
+
+
+/*------------------------------------------------------------------------------------------------------------+
+|                                                  Statistics                                                 |
++------------------------------------------------------------------------------------------------------------*/
+
+struct sample_summary {
+    size_t count;
+    double mean;
+    double variance;  // unbiased
+};
+
+sample_summary summarize(const std::span<const double> samples) {
+    sample_summary res { samples.size(), 0, 0 };
+    for(const double s: samples) {
+        res.mean += s;
+    }
+    res.mean /= static_cast<double>(samples.size());
+    if(samples.size() > 1) {
+        for(const double s: samples) {
+            res.variance += (s - res.mean) * (s - res.mean);
+        }
+        res.variance /= static_cast<double>(samples.size() - 1);
+    }
+    return res;
+}
+
+/// @brief two-sided 95% quantile of Student's t distribution
+double t_critical_95(const double degrees_of_freedom) {
+    static constexpr double table[] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+         2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+         2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if(!(degrees_of_freedom >= 1)) {
+        return table[0];
+    }
+    if(degrees_of_freedom <= 30) {
+        return table[static_cast<size_t>(degrees_of_freedom) - 1];  // rounding down is conservative
+    }
+    return (degrees_of_freedom <= 60) ? 2.000 : (degrees_of_freedom <= 120) ? 1.980 : 1.960;
+}
+
+/// @brief half-width of the 95% confidence interval of the mean
+double confidence_95(const sample_summary& s) {
+    if(s.count < 2) {
+        return 0;
+    }
+    return t_critical_95(static_cast<double>(s.count - 1)) * std::sqrt(s.variance / static_cast<double>(s.count));
+}
+
+struct difference {
+    double mean;  // current - baseline
+    double half_width;
+};
+
+/// @brief 95% Welch interval of the difference of the means
+difference welch_difference(const sample_summary& baseline, const sample_summary& current) {
+    const double vb = baseline.variance / static_cast<double>(baseline.count);
+    const double vc = current.variance / static_cast<double>(current.count);
+    const double standard_error = std::sqrt(vb + vc);
+    if(standard_error == 0 || baseline.count < 2 || current.count < 2) {
+        return { current.mean - baseline.mean, 0 };
+    }
+    const double df = (vb + vc) * (vb + vc)
+                    / (vb * vb / static_cast<double>(baseline.count - 1) + vc * vc / static_cast<double>(current.count - 1));
+    return { current.mean - baseline.mean, t_critical_95(df) * standard_error };
+}
+
+
+/*------------------------------------------------------------------------------------------------------------+
+|                                                  Baseline                                                   |
++------------------------------------------------------------------------------------------------------------*/
+
+struct bench_entry {
+    std::string day;
+    uint32_t part;
+    std::string input;
+    std::string build_type;
+    uint64_t input_size;
+    std::vector<double> samples_ns;
+
+    bool same_key(const bench_entry& other) const {
+        return day == other.day && part == other.part && input == other.input && build_type == other.build_type;
+    }
+};
+
+/// @brief the entries of a baseline, none if the file does not exist yet
+std::vector<bench_entry> load_baseline(const std::filesystem::path& path) {
+    std::vector<bench_entry> res;
+    if(!std::filesystem::exists(path)) {
+        return res;
+    }
+    const std::optional<std::string> text = read_file(path);
+    if(!text.has_value()) {
+        throw std::runtime_error("cannot read the baseline " + path.string());
+    }
+    const json_value document = parse_json(text.value());
+    for(const json_value& e: document["entries"].as_array()) {
+        bench_entry entry {
+            e["day"].as_string(),
+            static_cast<uint32_t>(e["part"].as_number()),
+            e["input"].as_string(),
+            e["build_type"].as_string(),
+            static_cast<uint64_t>(e["input_size"].as_number()),
+            {}
+        };
+        for(const json_value& s: e["samples_ns"].as_array()) {
+            entry.samples_ns.push_back(s.as_number());
+        }
+        res.push_back(std::move(entry));
+    }
+    return res;
+}
+
+void write_baseline(const std::filesystem::path& path, const std::vector<bench_entry>& entries) {
+    std::ostringstream out;
+    out << "{\n  \"entries\": [\n";
+    for(size_t i = 0; i < entries.size(); i++) {
+        const bench_entry& e = entries[i];
+        out << "    { \"day\": ";
+        write_json_string(out, e.day);
+        out << ", \"part\": " << e.part << ", \"input\": ";
+        write_json_string(out, e.input);
+        out << ", \"build_type\": ";
+        write_json_string(out, e.build_type);
+        out << ", \"input_size\": " << e.input_size << ",\n      \"samples_ns\": [";
+        for(size_t j = 0; j < e.samples_ns.size(); j++) {
+            out << (j > 0 ? ", " : "") << static_cast<uint64_t>(e.samples_ns[j]);
+        }
+        out << "] }" << (i + 1 < entries.size() ? "," : "") << '\n';
+    }
+    out << "  ]\n}\n";
+
+    // written at once, so that an interrupted run does not leave a truncated baseline
+    const std::filesystem::path tmp = path.string() + ".tmp";
+    std::ofstream file(tmp, std::ios::trunc);
+    file << out.str();
+    file.close();
+    if(!file) {
+        throw std::runtime_error("cannot write the baseline " + path.string());
+    }
+    std::filesystem::rename(tmp, path);
+}
+
+
+/*------------------------------------------------------------------------------------------------------------+
+|                                                  Measures                                                   |
++------------------------------------------------------------------------------------------------------------*/
+
+/// @brief times parsing and solving an input, after a first run to warm up the caches and the allocator
+bench_entry measure(const day_solver& solver, const std::filesystem::path& path, const bool part2, const uint32_t nb_samples) {
+    const std::optional<std::string> input = read_file(path);
+    if(!input.has_value()) {
+        throw std::runtime_error("cannot read file " + path.string());
+    }
+    bench_entry res { std::string(solver.day), part2 ? 2u : 1u, path.string(), AOC_BUILD_TYPE, input->length(), {} };
+    try {
+        solver.solve(input.value(), part2);
+        for(uint32_t i = 0; i < nb_samples; i++) {
+            const auto start = std::chrono::steady_clock::now();
+            solver.solve(input.value(), part2);
+            const std::chrono::nanoseconds time = std::chrono::steady_clock::now() - start;
+            res.samples_ns.push_back(static_cast<double>(time.count()));
+        }
+    } catch(const std::exception& e) {
+        throw std::runtime_error(path.string() + " : " + e.what());
+    }
+    return res;
+}
+
+
+/*------------------------------------------------------------------------------------------------------------+
+|                                                  Comparison                                                 |
++------------------------------------------------------------------------------------------------------------*/
+
+enum class verdict { unchanged, slower, regression, faster };
+
+std::string_view to_string(const verdict v) {
+    switch(v) {
+        case verdict::slower:     return "slower (within threshold)";
+        case verdict::regression: return "REGRESSION";
+        case verdict::faster:     return "faster";
+        default:                  return "~";
+    }
+}
+
+/// @brief the verdict for a change, with the relative threshold applying to slowdowns only
+verdict judge(const sample_summary& baseline, const difference& diff, const double threshold) {
+    if(diff.mean - diff.half_width > 0) {
+        return (diff.mean > threshold * baseline.mean) ? verdict::regression : verdict::slower;
+    }
+    if(diff.mean + diff.half_width < 0) {
+        return verdict::faster;
+    }
+    return verdict::unchanged;
+}
+
+void write_timing(std::ostream& out, const sample_summary& s) {
+    std::ostringstream cell;
+    cell << std::fixed << std::setprecision(3) << s.mean / 1e6 << " +/- " << confidence_95(s) / 1e6;
+    out << std::setw(24) << cell.str();
+}
+
+/// @brief compares the new measures with the baseline, and tells whether a regression exceeds the threshold
+bool report_comparison(std::ostream& out, const std::vector<bench_entry>& baseline, const std::vector<bench_entry>& current, const double threshold) {
+    bool regressed = false;
+    out << std::left << std::setw(32) << "input" << std::right << std::setw(6) << "part"
+        << std::setw(24) << "baseline (ms)" << std::setw(24) << "current (ms)" << std::setw(10) << "change" << "  verdict\n";
+    for(const bench_entry& entry: current) {
+        out << std::left << std::setw(32) << entry.input << std::right << std::setw(6) << entry.part;
+        const auto base = std::find_if(baseline.begin(), baseline.end(), [&entry](const bench_entry& b) { return b.same_key(entry); });
+        if(base == baseline.end()) {
+            out << "  no baseline for day " << entry.day << " in a " << entry.build_type << " build\n";
+            continue;
+        }
+        if(base->input_size != entry.input_size) {
+            out << "  the input changed since the baseline (" << base->input_size << " -> " << entry.input_size << " bytes)\n";
+            continue;
+        }
+        const sample_summary b = summarize(base->samples_ns);
+        const sample_summary c = summarize(entry.samples_ns);
+        const difference diff = welch_difference(b, c);
+        const verdict v = judge(b, diff, threshold);
+        write_timing(out, b);
+        write_timing(out, c);
+        out << std::setw(9) << std::fixed << std::setprecision(1) << std::showpos << 100 * diff.mean / b.mean << std::noshowpos
+            << "%  " << to_string(v) << '\n';
+        regressed |= (v == verdict::regression);
+    }
+    return regressed;
+}
+
+
+/*------------------------------------------------------------------------------------------------------------+
+|                                                  Main                                                       |
++------------------------------------------------------------------------------------------------------------*/
+
+template <typename T>
+std::optional<T> numeric_flag(const int argc, char** argv, const std::string_view flag, const T default_value) {
+    const std::optional<std::string_view> str = flag_value(argc, argv, flag);
+    if(!str.has_value()) {
+        return default_value;
+    }
+    T res {};
+    const auto [ptr, ec] = std::from_chars(str->data(), str->data() + str->length(), res);
+    if(ec != std::errc() || ptr != str->data() + str->length() || res <= 0) {
+        return std::nullopt;
+    }
+    return res;
+}
+
+int main(int argc, char** argv) {
+
+    std::ios::sync_with_stdio(false);
+
+    const std::vector<std::string_view> args = positional_arguments(argc, argv, { "--samples", "--threshold", "--baseline" });
+    if(args.size() < 3 || (args[0] != "record" && args[0] != "compare")) {
+        std::cerr << "usage: " << argv[0] << " <record|compare> <day> [--part2] [--samples N] [--threshold PERCENT] "
+                  << "[--baseline FILE] <directory or file>..." << std::endl;
+        return 2;
+    }
+
+    const day_solver* solver = find_day(args[1]);
+    if(solver == nullptr) {
+        std::cerr << "unknown day : " << args[1] << std::endl;
+        return 2;
+    }
+
+    const std::optional<uint32_t> nb_samples = numeric_flag<uint32_t>(argc, argv, "--samples", 10);
+    const std::optional<double> threshold_percent = numeric_flag<double>(argc, argv, "--threshold", 5.0);
+    if(!nb_samples.has_value() || !threshold_percent.has_value()) {
+        std::cerr << "invalid number of samples or threshold" << std::endl;
+        return 2;
+    }
+    const std::filesystem::path baseline_path(flag_value(argc, argv, "--baseline").value_or("bench-baseline.json"));
+    const bool part2 = has_flag(argc, argv, "--part2");
+
+    try {
+        std::vector<bench_entry> baseline = load_baseline(baseline_path);
+        std::vector<bench_entry> current;
+        for(const std::filesystem::path& input: list_inputs(std::span(args).subspan(2))) {
+            current.push_back(measure(*solver, input, part2, nb_samples.value()));
+        }
+
+        if(args[0] == "compare") {
+            const bool regressed = report_comparison(std::cout, baseline, current, threshold_percent.value() / 100);
+            return regressed ? 1 : 0;
+        }
+
+        for(bench_entry& entry: current) {
+            std::erase_if(baseline, [&entry](const bench_entry& b) { return b.same_key(entry); });
+            baseline.push_back(std::move(entry));
+        }
+        write_baseline(baseline_path, baseline);
+        std::cout << "recorded " << current.size() << " input(s) of day " << solver->day << " (" << AOC_BUILD_TYPE << " build) in "
+                  << baseline_path.string() << std::endl;
+    } catch(const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+
+    return 0;
+}
@@ -1,98 +1,65 @@
 
 #include <iostream>
+#include <optional>
+#include <string>
 #include <vector>
-#include <numeric>
 
+#include <days/day-02.hh>
+#include <utils/input.hh>
+#include <utils/pipeline.hh>
+#include <utils/args.hh>
+#include <utils/output.hh>
 #include <utils/split.hh>
 
 
-struct cubes {
-    uint32_t red = 0;
-    uint32_t green = 0;
-    uint32_t blue = 0;
-
-    uint64_t power() {
-        return red * green * blue;
-    }
-};
-
+int main(int argc, char** argv) {
 
-template <uint32_t red, uint32_t green, uint32_t blue>
-bool is_possible(const std::vector<cubes>& game) {
-    return std::all_of(game.begin(), game.end(), [](const cubes& cb) {
-        return cb.red <= red && cb.green <= green && cb.blue <= blue;
-    });
-}
+    const bool is_part_2 = has_flag(argc, argv, "--part2");
+    const auto solve = is_part_2 ? day02::solve_part2 : day02::solve_part1;
 
-uint64_t part1(const std::pair<uint32_t,std::vector<cubes>>& game) {
-    if(is_possible<12, 13, 14>(game.second)) {
-        return game.first;
+    // with --queries, the games may come from a file so that the queries can come from the standard input
+    const std::optional<std::string_view> games_path = flag_value(argc, argv, "--games");
+    const std::optional<std::string_view> queries_path = flag_value(argc, argv, "--queries");
+    if(games_path.value_or("-") == "-" && queries_path == "-") {
+        std::cerr << "the games and the queries cannot both come from the standard input" << std::endl;
+        return 2;
     }
-    return 0;
-}
 
-
-uint64_t part2(const std::pair<uint32_t,std::vector<cubes>>& game) {
-    cubes max;
-    for(const cubes& cb: game.second) {
-        if(cb.red > max.red) {
-            max.red = cb.red;
-        }
-        if(cb.green > max.green) {
-            max.green = cb.green;
-        }
-        if(cb.blue > max.blue) {
-            max.blue = cb.blue;
+    std::optional<std::string> games_repr;
+    if(games_path.has_value()) {
+        games_repr = read_path(games_path.value());
+        if(!games_repr.has_value()) {
+            std::cerr << "cannot read " << games_path.value() << std::endl;
+            return 2;
         }
     }
-    std::cout << "Min for game " << game.first << " : " << max.red << " red, " << max.green << " green, " << max.blue << " blue, " << std::endl;
-    return max.power();
-}
-
-
-int main(int argc, char** argv) {
 
-    const bool is_part_2 = (argc >= 2 && std::string("--part2") == argv[1]);
-	const auto compute = is_part_2 ? part2 : part1;
+    const day02::parsed input = games_repr.has_value()                ? day02::parse(games_repr.value())
+                              : has_flag(argc, argv, "--pipeline")     ? parse_pipelined<day02::parsed>(day02::parse_lines)
+                              :                                          day02::parse(read_all());
 
-    std::vector<std::pair<uint32_t,std::vector<cubes>>> games;
-
-    while(true) {
-		std::string line;
-        std::getline(std::cin, line);
-		if(std::cin.eof()) {
-			break;
-		}
-        if(line.length() > 0 && line.back() == '\n') {
-            line.pop_back();
+    if(queries_path.has_value()) {
+        // one bag per line, written as in the games : "12 red, 13 green, 14 blue"
+        const std::optional<std::string> queries_repr = read_path(queries_path.value());
+        if(!queries_repr.has_value()) {
+            std::cerr << "cannot read " << queries_path.value() << std::endl;
+            return 2;
         }
-        const auto [pre, list] = split_once(line, ": ");
-        const auto [_, num_repr] = split_once(pre, " ");
-        const uint32_t game_num = std::stoul(std::string(num_repr)); // TODO better conversion
-        std::vector<cubes> game;
-        for(const std::string_view grab: split(list, "; ")) {
-            cubes cb;
-            for(const std::string_view nb_cubes: split(grab, ", ")) {
-                auto [count_repr, colour] = split_once(nb_cubes, " ");
-                const uint32_t count = std::stoul(std::string(count_repr)); // TODO better conversion
-                if(colour == "red") {
-                    cb.red += count;
-                } else if(colour == "green") {
-                    cb.green += count;
-                } else { // colour == "blue"
-                    cb.blue += count;
-                }
+        std::vector<day02::cubes> bags;
+        for(const std::string_view line: split_on<"\n">(queries_repr.value())) {
+            if(line.length() > 0) {
+                bags.push_back(day02::parse_cubes(line));
             }
-            game.push_back(cb);
         }
-        games.push_back({ game_num, std::move(game) });
-	}
-
-    uint64_t sum = 0;
-    for(const auto& game: games) {
-        sum += compute(game);
+        const day02::feasibility_index index(input);
+        for(const uint64_t sum: index.sum_possible_ids(bags)) {
+            standard_output() << sum << '\n';
+        }
+        return 0;
     }
-    std::cout << "Sum of the game IDs : " << sum << std::endl;
+
+    const uint64_t sum = solve(input);
+    standard_output() << "Sum of the game IDs : " << sum << '\n';
 
     return 0;
 }
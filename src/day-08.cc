@@ -1,88 +1,62 @@
 
 #include <iostream>
-#include <algorithm>
-#include <memory>
-#include <unordered_map>
-#include <vector>
+#include <string>
 
-#include <utils/split.hh>
+#include <days/day-08.hh>
 #include <utils/input.hh>
+#include <utils/args.hh>
+#include <utils/output.hh>
+#include <utils/record.hh>
+#include <utils/split.hh>
 
 
-class lazy_node {
+int main(int argc, char** argv) {
 
-public:
-	lazy_node(std::string&& n, std::string&& l, std::string&& r): 
-		_name(std::move(n)), _left_name(std::move(l)), _right_name(std::move(r)), _left(nullptr), _right(nullptr) {}
+	const bool is_part_2 = has_flag(argc, argv, "--part2");
+	const auto solve = is_part_2 ? day08::solve_part2 : day08::solve_part1;
 
-	std::shared_ptr<lazy_node> go(char lr, const std::unordered_map<std::string,std::shared_ptr<lazy_node>>& nodes) {
-		if(lr == 'L') {
-			if(_left == nullptr) {
-				_left = nodes.at(_left_name);
-			}
-			return _left;
-		}
-		if(_right == nullptr) {
-			_right = nodes.at(_right_name);
-		}
-		return _right;
+	const std::optional<std::string_view> load_path = flag_value(argc, argv, "--load-parsed");
+	const day08::parsed input = load_path.has_value() ? day08::load(std::string(load_path.value()))
+	                            : day08::parse(read_all());
+	if(const std::optional<std::string_view> save_path = flag_value(argc, argv, "--save-parsed"); save_path.has_value()) {
+		day08::save(input, std::string(save_path.value()));
 	}
 
-	const std::string& name() const { return _name; }
-
-private:
-	const std::string _name;
-	const std::string _left_name;
-	const std::string _right_name;
-
-	std::shared_ptr<lazy_node> _left;
-	std::shared_ptr<lazy_node> _right;
-
-};
-
-
-uint32_t compute_steps(const std::unordered_map<std::string,std::shared_ptr<lazy_node>>& nodes, 
-			const std::string& directions, const std::string& start, const std::string& destination) {
-	uint32_t res = 0;
-	size_t pos = 0;
-	std::shared_ptr<lazy_node> n = nodes.at(start);
-	while(n->name() != destination) {
-		std::cout << n->name() << " --(" << directions[pos] << ")--> ";
-		n = n->go(directions[pos], nodes);
-		res++;
-		pos++;
-		if(pos >= directions.size()) {
-			pos = 0;
+	if(const std::optional<std::string_view> queries_path = flag_value(argc, argv, "--queries"); queries_path.has_value()) {
+		// one "START DESTINATION" pair per line, all answered by the same jump table
+		if(queries_path == "-" && !load_path.has_value()) {
+			std::cerr << "the network and the queries cannot both come from the standard input" << std::endl;
+			return 2;
 		}
-		std::cout << n->name() << " (d=" << res << ")" << std::endl;
-	}
-	return res;
-}
-
-
-int main() {
-
-	std::unordered_map<std::string,std::shared_ptr<lazy_node>> nodes;
-
-	std::string directions = read_line().value();
-	read_line();
-
-    while(true) {
-		std::optional<std::string> line = read_line();
-		if(!line.has_value()) {
-			break;
+		const std::optional<std::string> queries_repr = read_path(queries_path.value());
+		if(!queries_repr.has_value()) {
+			std::cerr << "cannot read " << queries_path.value() << std::endl;
+			return 2;
 		}
-		if(line.value().length() == 0) {
-			continue;
+		day08::pass_table table(input.nodes, input.directions);
+		for(const std::string_view line: split_on<"\n">(queries_repr.value())) {
+			if(line.length() == 0) {
+				continue;
+			}
+			const auto [start, destination] = read_record<"{} {}", std::string_view, std::string_view>(line);
+			const std::optional<uint64_t> steps = table.steps(start, destination);
+			if(steps.has_value()) {
+				standard_output() << steps.value() << '\n';
+			} else {
+				standard_output() << "-\n";
+			}
 		}
-		auto [name, directions_rep] = split_once(line.value(), " = ");
-		auto [left_name, right_name] = split_once(directions_rep.substr(1, directions_rep.length() - 2), ", ");
-		nodes[std::string(name)] = std::make_shared<lazy_node>(std::string(name), std::string(left_name), std::string(right_name));
+		return 0;
 	}
 
-	const uint32_t nb_steps = compute_steps(nodes, directions, "AAA", "ZZZ");
-	std::cout << "Number of steps : " << nb_steps << std::endl;
+	const std::optional<uint64_t> nb_steps = solve(input);
+	if(nb_steps.has_value()) {
+		standard_output() << "Number of steps : " << nb_steps.value() << '\n';
+	} else if(is_part_2) {
+		standard_output() << "The walkers are never all on a destination at the same time" << '\n';
+	} else {
+		standard_output() << "The destination is never reached" << '\n';
+	}
 
 	return 0;
 }
-
@@ -0,0 +1,104 @@
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include <malloc.h>
+
+#include <utils/alloc_tracking.hh>
+
+
+/*
+ |  Replacement of the global allocation functions, only linked into the
+ |  instrumentation build. Sizes are taken from malloc_usable_size on both
+ |  sides, so that unsized deletes balance the allocations they release.
+ |
+ |  The counters are a trivially constructible thread_local : no allocation
+ |  nor initialisation guard is involved when operator new first touches them.
+ */
+
+namespace {
+
+thread_local alloc_counters counters;
+
+void count_allocation(void* p) noexcept {
+    const int64_t size = static_cast<int64_t>(malloc_usable_size(p));
+    counters.allocations++;
+    counters.bytes += static_cast<uint64_t>(size);
+    counters.live += size;
+    counters.peak = std::max(counters.peak, counters.live);
+}
+
+void count_deallocation(void* p) noexcept {
+    if(p != nullptr) {
+        counters.live -= static_cast<int64_t>(malloc_usable_size(p));
+    }
+}
+
+void* allocate(const std::size_t size, const std::size_t alignment) noexcept {
+    void* res = nullptr;
+    if(alignment <= alignof(std::max_align_t)) {
+        res = std::malloc(std::max<std::size_t>(size, 1));
+    } else if(posix_memalign(&res, alignment, std::max<std::size_t>(size, 1)) != 0) {
+        res = nullptr;
+    }
+    if(res != nullptr) {
+        count_allocation(res);
+    }
+    return res;
+}
+
+void* allocate_or_throw(const std::size_t size, const std::size_t alignment) {
+    while(true) {
+        if(void* res = allocate(size, alignment); res != nullptr) {
+            return res;
+        }
+        const std::new_handler handler = std::get_new_handler();
+        if(handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void release(void* p) noexcept {
+    count_deallocation(p);
+    std::free(p);
+}
+
+}
+
+
+alloc_counters& thread_alloc_counters() noexcept {
+    return counters;
+}
+
+
+/*------------------------------------------------------------------------------------------------------------+
+|                                         Replaced allocation functions                                       |
++------------------------------------------------------------------------------------------------------------*/
+
+
+void* operator new(const std::size_t size) { return allocate_or_throw(size, alignof(std::max_align_t)); }
+void* operator new[](const std::size_t size) { return allocate_or_throw(size, alignof(std::max_align_t)); }
+void* operator new(const std::size_t size, const std::align_val_t al) { return allocate_or_throw(size, static_cast<std::size_t>(al)); }
+void* operator new[](const std::size_t size, const std::align_val_t al) { return allocate_or_throw(size, static_cast<std::size_t>(al)); }
+
+void* operator new(const std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, alignof(std::max_align_t)); }
+void* operator new[](const std::size_t size, const std::nothrow_t&) noexcept { return allocate(size, alignof(std::max_align_t)); }
+void* operator new(const std::size_t size, const std::align_val_t al, const std::nothrow_t&) noexcept { return allocate(size, static_cast<std::size_t>(al)); }
+void* operator new[](const std::size_t size, const std::align_val_t al, const std::nothrow_t&) noexcept { return allocate(size, static_cast<std::size_t>(al)); }
+
+void operator delete(void* p) noexcept { release(p); }
+void operator delete[](void* p) noexcept { release(p); }
+void operator delete(void* p, std::size_t) noexcept { release(p); }
+void operator delete[](void* p, std::size_t) noexcept { release(p); }
+void operator delete(void* p, std::align_val_t) noexcept { release(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { release(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { release(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { release(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { release(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { release(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept { release(p); }
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept { release(p); }
@@ -0,0 +1,138 @@
+
+#include <days/day-01.hh>
+
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <functional>
+
+#include <utils/split.hh>
+#include <utils/format.hh>
+#include <utils/parallel.hh>
+
+
+namespace day01 {
+
+
+constexpr uint64_t calibration_value_pt1(const std::string_view repr) {
+	const auto it_first = std::find_if(repr.begin(),  repr.end(),  is_number);
+	const auto it_last  = std::find_if(repr.rbegin(), repr.rend(), is_number);
+	return static_cast<uint64_t>( (*it_first - '0') * 10 + (*it_last - '0') );
+}
+
+
+constexpr std::array<std::pair<std::string_view,uint8_t>,9> digits = {{
+	{ "one",   1 }, 
+	{ "two",   2 },
+	{ "three", 3 },
+	{ "four",  4 },
+	{ "five",  5 },
+	{ "six",   6 },
+	{ "seven", 7 },
+	{ "eight", 8 },
+	{ "nine",  9 }
+}};
+
+constexpr uint64_t calibration_value_pt2(const std::string_view repr) {
+	const auto it_first = std::find_if(repr.begin(),  repr.end(),  is_number);
+	const auto it_last  = std::find_if(repr.rbegin(), repr.rend(), is_number);
+
+	uint8_t first = 0;
+	uint64_t first_idx = repr.length() - 1;
+	if(it_first != repr.end()) {
+		first = *it_first - '0';
+		first_idx = std::distance(repr.begin(), it_first);
+	}
+
+	uint8_t last = 0;
+	uint64_t last_idx = 0;
+	if(it_last != repr.rend()) {
+		last  = *it_last  - '0';
+		last_idx  = repr.length() - 1 - std::distance(repr.rbegin(), it_last);
+	}
+
+	for(const auto& d: digits) {
+		size_t idx = repr.find(d.first);
+		if(idx != std::string_view::npos && idx < first_idx) {
+			first_idx = idx;
+			first = d.second;
+			if(idx == 0) {
+				break;
+			}
+		}
+	}
+
+	for(const auto& d: digits) {
+		size_t idx = repr.rfind(d.first);
+		if(idx != std::string_view::npos && idx > last_idx) {
+			last_idx = idx;
+			last = d.second;
+			if(idx == repr.length() - 1) {
+				break;
+			}
+		}
+	}
+
+	return static_cast<uint64_t>( first * 10 + last );
+}
+
+
+void parse_lines(parsed& res, const std::string_view lines) {
+	for(const std::string_view line: split_on<"\n">(lines)) {
+		if(line.length() > 0) {
+			res.text.append(line);
+			res.text.push_back('\n');
+		}
+	}
+}
+
+parsed parse(const std::string_view input) {
+	parsed res;
+	parse_lines(res, input);
+	return res;
+}
+
+
+template <uint64_t (*CalibrationValue)(std::string_view), typename Lines>
+constexpr uint64_t sum_calibration_values(const Lines& lines) {
+	uint64_t total = 0;
+	for(const std::string_view line: lines) {
+		if(line.length() > 0) {
+			total += CalibrationValue(line);
+		}
+	}
+	return total;
+}
+
+
+/*
+ |  Regression tests on the examples of the puzzle, evaluated by the compiler
+ */
+
+static_assert(sum_calibration_values<calibration_value_pt1>(split_on<"\n">(
+	"1abc2\n"
+	"pqr3stu8vwx\n"
+	"a1b2c3d4e5f\n"
+	"treb7uchet\n"
+)) == 142);
+
+static_assert(sum_calibration_values<calibration_value_pt2>(split_on<"\n">(
+	"two1nine\n"
+	"eightwothree\n"
+	"abcone2threexyz\n"
+	"xtwone3four\n"
+	"4nineeightseven2\n"
+	"zoneight234\n"
+	"7pqrstsixteen\n"
+)) == 281);
+
+
+uint64_t solve_part1(const parsed& input) {
+	return map_reduce_lines(input.text, static_cast<uint64_t>(0), calibration_value_pt1, std::plus<>());
+}
+
+uint64_t solve_part2(const parsed& input) {
+	return map_reduce_lines(input.text, static_cast<uint64_t>(0), calibration_value_pt2, std::plus<>());
+}
+
+}
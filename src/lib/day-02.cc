@@ -0,0 +1,206 @@
+
+#include <days/day-02.hh>
+
+#include <vector>
+#include <functional>
+#include <numeric>
+#include <algorithm>
+#include <string>
+
+#include <utils/split.hh>
+#include <utils/format.hh>
+#include <utils/parallel.hh>
+#include <utils/record.hh>
+
+
+namespace day02 {
+
+template <uint32_t red, uint32_t green, uint32_t blue>
+bool is_possible(const std::pmr::vector<cubes>& game) {
+    return std::all_of(game.begin(), game.end(), [](const cubes& cb) {
+        return cb.red <= red && cb.green <= green && cb.blue <= blue;
+    });
+}
+
+uint64_t part1(const game& g) {
+    if(is_possible<12, 13, 14>(g.grabs)) {
+        return g.id;
+    }
+    return 0;
+}
+
+
+cubes minimum_cubes(const game& g) {
+    cubes max;
+    for(const cubes& cb: g.grabs) {
+        if(cb.red > max.red) {
+            max.red = cb.red;
+        }
+        if(cb.green > max.green) {
+            max.green = cb.green;
+        }
+        if(cb.blue > max.blue) {
+            max.blue = cb.blue;
+        }
+    }
+    return max;
+}
+
+uint64_t part2(const game& g) {
+    return minimum_cubes(g).power();
+}
+
+
+cubes parse_cubes(const std::string_view repr) {
+    cubes cb;
+    for(const std::string_view nb_cubes: split_on<", ">(repr)) {
+        const auto [count, colour] = read_record<"{} {}", uint32_t, std::string_view>(nb_cubes);
+        if(colour == "red") {
+            cb.red += count;
+        } else if(colour == "green") {
+            cb.green += count;
+        } else { // colour == "blue"
+            cb.blue += count;
+        }
+    }
+    return cb;
+}
+
+void parse_lines(parsed& res, const std::string_view lines) {
+    for(const std::string_view line: split_on<"\n">(lines)) {
+        if(line.length() == 0) {
+            continue;
+        }
+        const auto [game_num, list] = read_record<"Game {}: {}", uint32_t, std::string_view>(line);
+        std::pmr::vector<cubes> grabs(res.memory->resource());
+        for(const std::string_view grab: split_on<"; ">(list)) {
+            grabs.push_back(parse_cubes(grab));
+        }
+        res.games.push_back({ game_num, std::move(grabs) });
+    }
+}
+
+parsed parse(const std::string_view input) {
+    parsed res { std::make_unique<arena>(input.length()) };
+    parse_lines(res, input);
+    return res;
+}
+
+
+uint64_t solve_part1(const parsed& input) {
+    return map_reduce(std::span<const game>(input.games), static_cast<uint64_t>(0), part1, std::plus<>());
+}
+
+uint64_t solve_part2(const parsed& input) {
+    return map_reduce(std::span<const game>(input.games), static_cast<uint64_t>(0), part2, std::plus<>());
+}
+
+
+
+/*-----------------+
+|  Bag queries     |
++------------------*/
+
+
+/// @brief the sorted distinct values
+std::vector<uint32_t> distinct(std::vector<uint32_t> values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return values;
+}
+
+/// @brief the number of sorted values that are at most the bound
+size_t count_at_most(const std::vector<uint32_t>& sorted, const uint32_t bound) {
+    return static_cast<size_t>(std::upper_bound(sorted.begin(), sorted.end(), bound) - sorted.begin());
+}
+
+
+feasibility_index::feasibility_index(const parsed& input) {
+    std::vector<cubes> minima;
+    std::vector<uint32_t> greens;
+    std::vector<uint32_t> blues;
+    minima.reserve(input.games.size());
+    for(const game& g: input.games) {
+        minima.push_back(minimum_cubes(g));
+        greens.push_back(minima.back().green);
+        blues.push_back(minima.back().blue);
+    }
+    _greens = distinct(std::move(greens));
+    _blues = distinct(std::move(blues));
+
+    _games.reserve(minima.size());
+    for(size_t i = 0; i < minima.size(); i++) {
+        // ranks of the exact values, which are present
+        _games.push_back({
+            minima[i].red,
+            static_cast<uint32_t>(count_at_most(_greens, minima[i].green) - 1),
+            static_cast<uint32_t>(count_at_most(_blues, minima[i].blue) - 1),
+            input.games[i].id
+        });
+    }
+    std::sort(_games.begin(), _games.end(), [](const reduced_game& g1, const reduced_game& g2) { return g1.red < g2.red; });
+
+    // each game goes to the nodes of the green tree that an update of its green rank touches
+    std::vector<std::vector<uint32_t>> nodes(_greens.size());
+    for(const reduced_game& g: _games) {
+        for(size_t i = g.green_rank + 1; i <= _greens.size(); i += i & -i) {
+            nodes[i-1].push_back(g.blue_rank);
+        }
+    }
+    _node_offsets.reserve(nodes.size() + 1);
+    _node_offsets.push_back(0);
+    for(std::vector<uint32_t>& node: nodes) {
+        const std::vector<uint32_t> blue_ranks = distinct(std::move(node));
+        _node_blue_ranks.insert(_node_blue_ranks.end(), blue_ranks.begin(), blue_ranks.end());
+        _node_offsets.push_back(static_cast<uint32_t>(_node_blue_ranks.size()));
+    }
+}
+
+std::span<const uint32_t> feasibility_index::node_blue_ranks(const size_t node) const {
+    return std::span<const uint32_t>(_node_blue_ranks).subspan(_node_offsets[node-1], _node_offsets[node] - _node_offsets[node-1]);
+}
+
+std::vector<uint64_t> feasibility_index::sum_possible_ids(const std::span<const cubes> bags) const {
+    std::vector<size_t> order(bags.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&bags](const size_t q1, const size_t q2) { return bags[q1].red < bags[q2].red; });
+
+    // the inner Fenwick trees, one after the other in the layout of the index
+    std::vector<uint64_t> sums(_node_blue_ranks.size(), 0);
+    const auto add = [this, &sums](const reduced_game& g) {
+        for(size_t i = g.green_rank + 1; i <= _greens.size(); i += i & -i) {
+            const std::span<const uint32_t> blue_ranks = node_blue_ranks(i);
+            uint64_t* node_sums = sums.data() + _node_offsets[i-1];
+            const size_t position = static_cast<size_t>(std::lower_bound(blue_ranks.begin(), blue_ranks.end(), g.blue_rank) - blue_ranks.begin());
+            for(size_t j = position + 1; j <= blue_ranks.size(); j += j & -j) {
+                node_sums[j-1] += g.id;
+            }
+        }
+    };
+    // sum of the games with a green rank below nb_greens and a blue rank below nb_blues
+    const auto prefix_sum = [this, &sums](const size_t nb_greens, const size_t nb_blues) {
+        uint64_t res = 0;
+        for(size_t i = nb_greens; i > 0; i -= i & -i) {
+            const std::span<const uint32_t> blue_ranks = node_blue_ranks(i);
+            const uint64_t* node_sums = sums.data() + _node_offsets[i-1];
+            const size_t count = static_cast<size_t>(std::lower_bound(blue_ranks.begin(), blue_ranks.end(), nb_blues) - blue_ranks.begin());
+            for(size_t j = count; j > 0; j -= j & -j) {
+                res += node_sums[j-1];
+            }
+        }
+        return res;
+    };
+
+    std::vector<uint64_t> res(bags.size(), 0);
+    size_t next_game = 0;
+    for(const size_t q: order) {
+        const cubes& bag = bags[q];
+        for(; next_game < _games.size() && _games[next_game].red <= bag.red; next_game++) {
+            add(_games[next_game]);
+        }
+        res[q] = prefix_sum(count_at_most(_greens, bag.green), count_at_most(_blues, bag.blue));
+    }
+    return res;
+}
+
+}
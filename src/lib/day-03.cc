@@ -0,0 +1,264 @@
+
+#include <days/day-03.hh>
+
+#include <vector>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <span>
+#include <tuple>
+
+#include <utils/format.hh>
+#include <utils/split.hh>
+
+
+namespace day03 {
+
+std::pair<size_t,size_t> find_number_range(const schematic& lines, size_t pos) {
+    size_t begin = pos;
+    while(is_number(lines[begin-1])) {
+        begin--;
+    }
+
+    size_t end = pos+1;
+    while(is_number(lines[end])) {
+        end++;
+    }
+
+    return { begin, end };
+}
+
+uint64_t read_number(const schematic& lines, size_t begin, size_t end) {
+    uint64_t res = 0;
+    for(size_t i = begin; i < end; i++) {
+        res = res * 10 + (lines[i] - '0');
+    }
+    return res;
+}
+
+
+
+/*-----------------+
+|  First Part      |
++------------------*/
+
+
+/*
+ |  A number is a part number if one of its digits touches a symbol, including
+ |  diagonally. With one bit per cell, 64 columns at a time :
+ |
+ |   - the symbols of the rows above, at and below a row are OR-ed together,
+ |     then OR-ed with themselves shifted by one column to the left and to the
+ |     right : this dilated mask has the cells touching a symbol
+ |   - AND-ed with the digits, it gives the digits touching a symbol
+ |   - these hits are grown along the digits until they stop changing, which
+ |     covers the whole numbers they belong to
+ |
+ |  The shifts carry the bits crossing from a word to its neighbours, so that
+ |  rows can be wider than 64 columns.
+ */
+
+
+struct bitboards {
+    packed_grid<1> digits;
+    packed_grid<1> symbols;
+};
+
+/// @brief gathers 8 bytes that are 0 or 1 into 8 bits, the first byte giving the lowest bit
+uint64_t pack_flags(const uint8_t* flags) {
+    uint64_t bytes = 0;
+    std::memcpy(&bytes, flags, sizeof(bytes));
+    return (bytes * 0x0102040810204080) >> 56;
+}
+
+/// @brief masks of the digits and of the symbols (anything but digits and '.') of 64 cells
+/// @note the byte comparisons are vectorised, the multiplications then play the part of a movemask
+std::pair<uint64_t,uint64_t> classify_chunk(const char* chunk) {
+    alignas(64) uint8_t digit_flags[64];
+    alignas(64) uint8_t symbol_flags[64];
+    #pragma omp simd
+    for(size_t k = 0; k < 64; k++) {
+        const uint8_t digit = static_cast<uint8_t>(static_cast<unsigned char>(chunk[k] - '0') < 10);
+        digit_flags[k] = digit;
+        symbol_flags[k] = static_cast<uint8_t>(!digit && chunk[k] != '.');
+    }
+    uint64_t digits = 0;
+    uint64_t symbols = 0;
+    for(size_t k = 0; k < 64; k += 8) {
+        digits  |= pack_flags(digit_flags + k)  << k;
+        symbols |= pack_flags(symbol_flags + k) << k;
+    }
+    return { digits, symbols };
+}
+
+/// @brief masks of the digits and of the symbols of the whole schematic, one bit per cell
+bitboards classify_cells(const schematic& cells) {
+    bitboards res { packed_grid<1>(cells.width(), cells.height()), packed_grid<1>(cells.width(), cells.height()) };
+    char last_chunk[64];
+    for(size_t y = 0; y < cells.height(); y++) {
+        const std::span<const char> line = cells.row(y);
+        const std::span<uint64_t> digits = res.digits.row(y);
+        const std::span<uint64_t> symbols = res.symbols.row(y);
+        for(size_t w = 0; w < digits.size(); w++) {
+            const char* chunk = line.data() + 64 * w;
+            if(line.size() - 64 * w < 64) { // the end of the row is padded with empty cells
+                std::fill(std::copy(chunk, line.data() + line.size(), last_chunk), last_chunk + 64, '.');
+                chunk = last_chunk;
+            }
+            std::tie(digits[w], symbols[w]) = classify_chunk(chunk);
+        }
+    }
+    return res;
+}
+
+/// @brief the word with each cell OR-ed with its left and right neighbours, across word boundaries
+uint64_t dilate_horizontally(const std::span<const uint64_t> row, const size_t w) {
+    const uint64_t previous = (w > 0) ? row[w-1] : 0;
+    const uint64_t next = (w + 1 < row.size()) ? row[w+1] : 0;
+    return row[w] | (row[w] << 1) | (previous >> 63) | (row[w] >> 1) | (next << 63);
+}
+
+/// @brief the digits of a row that belong to a number touching a symbol
+void mark_part_digits(const bitboards& boards, const size_t y, std::vector<uint64_t>& parts, std::vector<uint64_t>& around) {
+    const size_t nb_words = boards.symbols.words_per_row();
+    const std::span<const uint64_t> digits = boards.digits.row(y);
+    for(size_t w = 0; w < nb_words; w++) {
+        around[w] = boards.symbols.row(y)[w];
+        if(y > 0) {
+            around[w] |= boards.symbols.row(y-1)[w];
+        }
+        if(y + 1 < boards.symbols.height()) {
+            around[w] |= boards.symbols.row(y+1)[w];
+        }
+    }
+    for(size_t w = 0; w < nb_words; w++) {
+        parts[w] = dilate_horizontally(around, w) & digits[w];
+    }
+    bool changed = true;
+    while(changed) {
+        changed = false;
+        for(size_t w = 0; w < nb_words; w++) {
+            const uint64_t grown = dilate_horizontally(parts, w) & digits[w];
+            changed |= (grown != parts[w]);
+            parts[w] = grown;
+        }
+    }
+}
+
+/// @brief the sum of the numbers of a row whose digits are all set in the mask
+uint64_t sum_marked_numbers(const std::span<const char> line, const std::vector<uint64_t>& parts) {
+    uint64_t res = 0;
+    size_t next_x = 0; // end of the last number read, which may continue in the next word
+    for(size_t w = 0; w < parts.size(); w++) {
+        uint64_t bits = parts[w];
+        if(next_x > 64 * w) {
+            bits = (next_x - 64 * w >= 64) ? 0 : (bits & (~static_cast<uint64_t>(0) << (next_x - 64 * w)));
+        }
+        while(bits != 0) {
+            size_t x = 64 * w + static_cast<size_t>(std::countr_zero(bits));
+            uint64_t number = 0;
+            for(; x < line.size() && is_number(line[x]); x++) {
+                number = number * 10 + static_cast<uint64_t>(line[x] - '0');
+            }
+            res += number;
+            next_x = x;
+            bits = (x - 64 * w >= 64) ? 0 : (bits & (~static_cast<uint64_t>(0) << (x - 64 * w)));
+        }
+    }
+    return res;
+}
+
+
+uint64_t process_lines_pt1(const schematic& lines) {
+    const bitboards boards = classify_cells(lines);
+    std::vector<uint64_t> parts(boards.digits.words_per_row());
+    std::vector<uint64_t> around(boards.digits.words_per_row());
+
+    uint64_t res = 0;
+    for(size_t y = 0; y < lines.height(); y++) {
+        mark_part_digits(boards, y, parts, around);
+        res += sum_marked_numbers(lines.row(y), parts);
+    }
+    return res;
+}
+
+
+
+/*-----------------+
+|  Second Part      |
++------------------*/
+
+
+uint64_t parse_number(const schematic& lines, size_t pos, uint8_t& success_count) {
+    if(!is_number(lines[pos])) {
+        return 1;
+    }
+
+    success_count++; // usually a bad idea but extremely convenient here
+    const auto [begin, end] = find_number_range(lines, pos);
+
+    return read_number(lines, begin, end);
+}
+
+
+uint64_t process_lines_pt2(const schematic& lines) {
+    uint64_t res = 0;
+    const std::ptrdiff_t top    = lines.offset(0, -1);
+    const std::ptrdiff_t bottom = lines.offset(0,  1);
+
+    for(size_t i = 0; i < lines.height(); i++) {
+        for(size_t j = 0; j < lines.width(); j++) {
+            const size_t pos = lines.index(j, i);
+            if(lines[pos] != '*') {
+                continue;
+            }
+            uint8_t number_count = 0;
+            uint64_t ratio = 1;
+            // A number right above (or below) covers both diagonals as well
+            for(const std::ptrdiff_t vertical: { top, bottom }) {
+                if(is_number(lines[pos + vertical])) {
+                    ratio *= parse_number(lines, pos + vertical, number_count);
+                } else {
+                    ratio *= parse_number(lines, pos + vertical - 1, number_count);
+                    ratio *= parse_number(lines, pos + vertical + 1, number_count);
+                }
+            }
+            ratio *= parse_number(lines, pos - 1, number_count);
+            ratio *= parse_number(lines, pos + 1, number_count);
+            if(number_count == 2) {
+                res += ratio;
+            }
+        }
+    }
+
+    return res;
+}
+
+
+
+parsed parse(const std::string_view input) {
+    std::vector<std::string_view> lines;
+    size_t width = 0;
+    for(const std::string_view line: split(input, "\n")) {
+        if(line.length() > 0) {
+            lines.push_back(line);
+            width = std::max(width, line.size());
+        }
+    }
+    parsed res = { schematic(width, lines.size(), '.') };
+    for(size_t i = 0; i < lines.size(); i++) {
+        std::copy(lines[i].begin(), lines[i].end(), res.cells.row(i).begin());
+    }
+    return res;
+}
+
+
+uint64_t solve_part1(const parsed& input) {
+    return process_lines_pt1(input.cells);
+}
+
+uint64_t solve_part2(const parsed& input) {
+    return process_lines_pt2(input.cells);
+}
+
+}
@@ -0,0 +1,88 @@
+
+#include <days/day-04.hh>
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <span>
+#include <string>
+
+#include <utils/split.hh>
+#include <utils/format.hh>
+#include <utils/parallel.hh>
+#include <utils/record.hh>
+
+
+namespace day04 {
+
+uint32_t card_value(const card& c) {
+	uint32_t res = 0;
+	for(uint32_t n: c.we_have) {
+		if(c.winning.find(n) != c.winning.end()) {
+			res = (res == 0) ? 1 : (res << 1);
+		}
+	}
+	return res;
+}
+
+uint32_t card_matches(const card& c) {
+	return std::count_if(c.we_have.begin(), c.we_have.end(), [&c](uint32_t n) {
+		return (c.winning.find(n) != c.winning.end());
+	});
+} 
+
+
+uint64_t compute_values(const std::pmr::vector<card>& cards) {
+	return map_reduce(std::span<const card>(cards), static_cast<uint64_t>(0), card_value, std::plus<>());
+}
+
+
+uint64_t nb_cards(const std::pmr::vector<card>& cards) {
+	uint64_t sum = 0;
+	std::vector<uint32_t> counts(cards.size(), 1);
+	for(size_t i = 0; i < cards.size(); i++) {
+		const uint32_t nb_matches = card_matches(cards[i]);
+		for(size_t j = 1; j <= nb_matches && (i+j) < cards.size(); j++) {
+			counts[i+j] += counts[i];
+		}
+		sum += counts[i];
+	}
+	return sum;
+}
+
+
+void parse_lines(parsed& res, const std::string_view lines) {
+	for(const std::string_view line: split_on<"\n">(lines)) {
+		if(line.length() == 0) {
+			continue;
+		}
+		card c(res.memory->resource());
+		const auto [_, we_have_repr, winning_repr] = read_record<"Card {}: {} | {}", uint32_t, std::string_view, std::string_view>(line);
+		for(const std::string_view repr: split_on<" ">(we_have_repr)) {
+			if(repr.length() == 0) { continue; }
+			c.we_have.insert(parse_unsigned(repr));
+		}
+		for(const std::string_view repr: split_on<" ">(winning_repr)) {
+			if(repr.length() == 0) { continue; }
+			c.winning.insert(parse_unsigned(repr));
+		}
+		res.cards.push_back(std::move(c));
+	}
+}
+
+parsed parse(const std::string_view input) {
+	parsed res { std::make_unique<arena>(4 * input.length()) };
+	parse_lines(res, input);
+	return res;
+}
+
+
+uint64_t solve_part1(const parsed& input) {
+	return compute_values(input.cards);
+}
+
+uint64_t solve_part2(const parsed& input) {
+	return nb_cards(input.cards);
+}
+
+}
@@ -0,0 +1,127 @@
+
+#include <days/day-05.hh>
+
+#include <vector>
+#include <algorithm>
+#include <string>
+
+#include <utils/split.hh>
+#include <utils/format.hh>
+#include <utils/snapshot.hh>
+
+
+namespace day05 {
+
+uint32_t min_location_pt1(const std::vector<uint32_t>& seeds, const std::vector<range_map>& maps) {
+	uint32_t res = 0xffffffff;
+	for(uint32_t seed: seeds) {
+		for(const range_map& mapping: maps) {
+			seed = mapping[seed];
+		}
+		res = (res < seed) ? res : seed;
+	}
+	return res;
+}
+
+uint32_t min_location_pt2(const std::vector<uint32_t>& seeds, const std::vector<range_map>& maps) {
+	uint32_t res = 0xffffffff;
+	for(size_t i = 0; i < seeds.size()-1; i += 2) {
+		#pragma omp parallel for shared(res)
+		for(uint32_t j = 0; j < seeds[i+1]; j++) {
+			uint32_t seed = seeds[i] + j;
+			for(const range_map& mapping: maps) {
+				seed = mapping[seed];
+			}
+			if(seed < res) {
+				#pragma omp critical
+				res = seed;
+			}
+		}
+	}
+	return res;
+}
+
+
+parsed parse(const std::string_view input) {
+	parsed res;
+	for(const std::string_view line: split_on<"\n">(input)) {
+		if(line.length() == 0) {
+			continue;
+		}
+		if(res.seeds.size() == 0) {
+			auto [_, seeds_repr] = split_once<": ">(line);
+			for(const std::string_view repr: split_on<" ">(seeds_repr)) {
+				res.seeds.push_back(parse_unsigned(repr));
+			}
+			continue;
+		}
+		if(line.back() == ':') { // e.g. "seed-to-soil map:"
+			res.maps.emplace_back();
+			continue;
+		}
+		split split_line(line, " ");
+		const std::vector<std::string_view> split_entry(split_line.begin(), split_line.end());
+		res.maps.back().add_entry(
+			parse_unsigned(split_entry[1]),
+			parse_unsigned(split_entry[0]),
+			parse_unsigned(split_entry[2])
+		);
+	}
+	return res;
+}
+
+
+/*
+ |  Snapshot sections : the seeds, the entries of all the maps one after the
+ |  other, and the number of entries of each map.
+ */
+
+constexpr uint32_t snapshot_day = 5;
+constexpr uint32_t snapshot_layout = 1;
+
+void save(const parsed& input, const std::filesystem::path& path) {
+	std::vector<range_map::entry> entries;
+	std::vector<uint32_t> sizes;
+	for(const range_map& m: input.maps) {
+		entries.insert(entries.end(), m.entries().begin(), m.entries().end());
+		sizes.push_back(m.entries().size());
+	}
+	snapshot_writer writer(snapshot_day, snapshot_layout);
+	writer.add(std::span<const uint32_t>(input.seeds));
+	writer.add(std::span<const range_map::entry>(entries));
+	writer.add(std::span<const uint32_t>(sizes));
+	writer.write(path);
+}
+
+parsed load(const std::filesystem::path& path) {
+	const snapshot snap(path, snapshot_day, snapshot_layout);
+	const std::span<const uint32_t> seeds = snap.section<uint32_t>(0);
+	const std::span<const range_map::entry> entries = snap.section<range_map::entry>(1);
+	const std::span<const uint32_t> sizes = snap.section<uint32_t>(2);
+
+	parsed res;
+	res.seeds.assign(seeds.begin(), seeds.end());
+	size_t offset = 0;
+	for(const uint32_t size: sizes) {
+		if(offset + size > entries.size()) {
+			throw std::runtime_error("inconsistent snapshot " + path.string());
+		}
+		res.maps.emplace_back(entries.subspan(offset, size));
+		offset += size;
+	}
+	if(offset != entries.size()) {
+		throw std::runtime_error("inconsistent snapshot " + path.string());
+	}
+	return res;
+}
+
+
+uint32_t solve_part1(const parsed& input) {
+	return min_location_pt1(input.seeds, input.maps);
+}
+
+uint32_t solve_part2(const parsed& input) {
+	return min_location_pt2(input.seeds, input.maps);
+}
+
+}
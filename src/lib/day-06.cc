@@ -0,0 +1,183 @@
+
+#include <days/day-06.hh>
+
+#include <vector>
+#include <array>
+
+#include <utils/split.hh>
+#include <utils/format.hh>
+
+
+namespace day06 {
+
+
+/*
+ |  We know that :
+ |    - distance = speed * time_moving
+ |    - speed = hold_duration
+ |    - time_moving = race_duration - hold_duration
+ |    - 0 <= hold_duration <= race_duration
+ |
+ |  ==> distance = hold_duration * (race_duration - hold_duration)
+ |
+ |  We assume that :
+ |   - record > 0
+ |
+ |  In order to beat the record, we have to travel a greater distance than the record :
+ |
+ |      distance > record
+ |  <=> hold_duration * (race_duration - hold_duration) > record
+ |  <=> (hold_duration * race_duration) - (hold_duration)² - record > 0
+ |
+ |  Let f be the function : f(t) = -t² + race_duration * t - record
+ |
+ |  We want to find the values of t for which f(t) > 0
+ |
+ |  f'(t) = race_duration - 2t
+ |
+ |  +-------+-------------------------------------------------+
+ |  | t     |     0         race_duration/2     race_duration |
+ |  +-------+-------------------------------------------------+
+ |  | f'(t) |          +           0           -              |
+ |  +-------+-------------------------------------------------+
+ |  | f     |                   maximum                       |
+ |  |       |      increasing              decreasing         |
+ |  +-------+-------------------------------------------------+
+ |
+ |  We can see that the function increases and then decreases.
+ |  It can potentially cross the y axis :
+ |   - twice (negative -> positive -> negative)
+ |   - once (maximum is zero, strictly negative everywhere else)
+ |   - 0 times (always strictly negative)
+ |
+ |  Note: f cannot be always strictly positive since f(0) = f(race_duration) = -record < 0
+ |
+ |  delta = b² - 4ac
+ |        = (race_duration)² - 4 * (-1) * (- record)
+ |        = (race_duration)² - 4 * record
+ |
+ |  Case delta < 0 : f is always negative, there are no solutions
+ |
+ |  Case delta = 0 :
+ |      The maximum of f is zero, reached at t = race_duration/2 : the record is
+ |      at best equalled, never beaten, so there are no solutions
+ |
+ |  Case delta > 0 :
+ |      The function crosses the y axis in two points :
+ |       - t1 = (-b + sqrt(delta)) / 2a = (race_duration - sqrt(delta)) / 2
+ |       - t2 = (-b - sqrt(delta)) / 2a = (race_duration + sqrt(delta)) / 2
+ |
+ |      With t1 < t2
+ |
+ |      The solutions are the integers strictly between t1 and t2 (f is zero on
+ |      the roots themselves, which only equal the record)
+ |
+ |      Since f(0) < 0 and f(race_duration) < 0, we know that 0 < t1 < t2 < race_duration
+ |      Hence, we don't need to check the boundaries of the races
+ */
+
+/*
+ |  The square root is computed on integers, so that the count is exact for any
+ |  delta that fits in 64 bits (a double cannot represent all of them) and so that
+ |  the whole computation can be carried out at compile time.
+ |
+ |  With s = isqrt(delta), floor((race_duration - s) / 2) is at most the first
+ |  solution, and floor((race_duration + s + 1) / 2) at least the last one, each
+ |  within one step. Instead of tracking whether the roots are integers, both
+ |  bounds are nudged inwards until they beat the record : when delta = 0, they
+ |  cross and there are no solutions.
+ */
+
+/// @brief largest integer whose square is at most n
+constexpr uint64_t isqrt(const uint64_t n) {
+	if(n < 2) {
+		return n;
+	}
+	uint64_t x = n;
+	uint64_t y = (x + 1) / 2;
+	while(y < x) {
+		x = y;
+		y = (x + n / x) / 2;
+	}
+	return x;
+}
+
+constexpr bool beats_record(const boat_race& r, const uint64_t hold_duration) {
+	return hold_duration * (r.duration - hold_duration) > r.record;
+}
+
+constexpr uint64_t compute_number_wins(const boat_race& r) {
+	const int64_t delta = static_cast<int64_t>(r.duration * r.duration) - 4 * static_cast<int64_t>(r.record);
+	if(delta < 0) {
+		return 0; // should not actually happen
+	}
+	const uint64_t sqrt_delta = isqrt(static_cast<uint64_t>(delta));
+	uint64_t first = (r.duration - sqrt_delta) / 2;
+	uint64_t last  = (r.duration + sqrt_delta + 1) / 2;
+	while(first <= last && !beats_record(r, first)) {
+		first++;
+	}
+	while(last >= first && !beats_record(r, last)) {
+		last--;
+	}
+	return (first <= last) ? (last - first + 1) : 0;
+}
+
+
+template <typename Races>
+constexpr uint64_t process_races(const Races& races) {
+	uint64_t res = 1;
+	for(const boat_race& r: races) {
+		res *= compute_number_wins(r);
+	}
+	return res;
+}
+
+
+parsed parse(const std::string_view input) {
+	const auto [times, rest] = split_once<"\n">(input);
+	const std::string_view distances = split_once<"\n">(rest).first;
+
+	parsed res;
+	for(const std::string_view repr: split_on<" ">(split_once<": ">(times).second)) {
+		if(repr.length() == 0) {
+			continue;
+		}
+		res.races.push_back({ parse_unsigned(repr), 0 });
+	}
+
+	size_t i = 0;
+	for(const std::string_view repr: split_on<" ">(split_once<": ">(distances).second)) {
+		if(repr.length() == 0) {
+			continue;
+		}
+		res.races[i].record = parse_unsigned(repr);
+		i++;
+	}
+
+	res.single_race = { parse_digits(times), parse_digits(distances) };
+
+	return res;
+}
+
+
+/*
+ |  Regression tests on the example of the puzzle, evaluated by the compiler
+ */
+
+constexpr std::array<boat_race,3> example_races = {{ { 7, 9 }, { 15, 40 }, { 30, 200 } }};
+static_assert(compute_number_wins(example_races[0]) == 4);
+static_assert(process_races(example_races) == 288);
+static_assert(compute_number_wins({ 71530, 940200 }) == 71503);
+static_assert(compute_number_wins({ 10, 25 }) == 0); // the best distance only ties the record
+
+
+uint64_t solve_part1(const parsed& input) {
+	return process_races(input.races);
+}
+
+uint64_t solve_part2(const parsed& input) {
+	return compute_number_wins(input.single_race);
+}
+
+}
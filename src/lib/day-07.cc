@@ -0,0 +1,226 @@
+
+#include <days/day-07.hh>
+
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <unordered_map>
+
+#include <utils/split.hh>
+#include <utils/format.hh>
+#include <utils/record.hh>
+#include <utils/snapshot.hh>
+
+
+namespace day07 {
+
+enum class part { one, two };
+
+
+template <part Part>
+bool compare_cards(char c1, char c2) {
+	if constexpr(Part == part::two) {
+		// Nothing is strictly smaller than J
+		if(c2 == 'J') {
+			return false;
+		}
+		// J is strictly smaller than anything but itself
+		// (the second case has already been taken care of)
+		if(c1 == 'J') {
+			return true;
+		}
+	}
+	// Letters are stronger than numbers
+	if(is_number(c1)) {
+		// Numbers can be arranged by lexicographic order
+		if(is_number(c2)) {
+			return c1 < c2;
+		}
+		return true;
+	}
+	if(is_number(c2)) {
+		return false;
+	}
+	if constexpr(Part == part::one) {
+		// Now both cards can be any letter
+		// If the second card is a J, the only way for the first
+		// to be greater is for it to be a T
+		if(c2 == 'J') {
+			return (c1 == 'T');
+		}
+		// Knowing that the second card is any letter but J,
+		// if the first card is a J it is always smaller,
+		// unless the second is a T
+		if(c1 == 'J') {
+			return (c2 != 'T');
+		}
+	}
+	// Reverse lexicographic order works fine for the rest of the letters
+	return c1 > c2;
+}
+
+
+template <part Part>
+class card_hand {
+
+public:
+	enum class hand_type {
+		five_of_a_kind  = 7,
+		four_of_a_kind  = 6,
+		full_house      = 5,
+		three_of_a_kind = 4,
+		two_pair        = 3,
+		one_pair        = 2,
+		high_card       = 1
+	};
+
+	card_hand(const std::string_view cards, const uint32_t value): 
+		_cards(cards), _type(compute_type(_cards)), _value(value) {}
+	
+	uint32_t bid() const { return _value; }
+	
+	bool operator<(const card_hand<Part>& other) const {
+		if(_type != other._type) {
+			return static_cast<uint8_t>(_type) < static_cast<uint8_t>(other._type);
+		}
+		for(size_t i = 0; i < 5; i++) {
+			if(_cards[i] != other._cards[i]) {
+				return compare_cards<Part>(_cards[i], other._cards[i]);
+			}
+		}
+		return false; // both hands are equal
+	}
+
+private:
+	std::string _cards;
+	hand_type _type;
+	uint32_t _value;
+
+	static hand_type compute_type(const std::string& cards) {
+		std::unordered_map<char,uint8_t> counter;
+		for(const char c: cards) {
+			// Note: if the card is not already in the map,
+			//       the value is default-initialized to 0
+			counter[c]++;
+		}
+		uint8_t wildcard_count = 0;
+		if constexpr(Part == part::two) {
+			const auto it = counter.find('J');
+			if(it != counter.end() && it->second < 5) {
+				wildcard_count += it->second;
+				counter.erase(it);
+			}
+		}
+		const auto max_it = std::max_element(
+			counter.begin(), counter.end(), 
+			[](const std::pair<char,uint8_t>& e1, const std::pair<char,uint8_t>& e2) {
+        		return e1.second < e2.second;
+    		}
+		);
+		max_it->second += wildcard_count;
+		const uint8_t max_count = max_it->second;
+		if(max_count == 5) {
+			return hand_type::five_of_a_kind;
+		}
+		if(max_count == 4) {
+			return hand_type::four_of_a_kind;
+		}
+		if(max_count == 1) {
+			return hand_type::high_card;
+		}
+		if(max_count == 2) {
+			return (counter.size() == 4) ? hand_type::one_pair : hand_type::two_pair;
+		}
+		// max_count == 3
+		return (counter.size() == 2) ? hand_type::full_house : hand_type::three_of_a_kind;
+	}
+
+};
+
+template <part Part>
+uint64_t winnings(std::vector<card_hand<Part>>& hands) {
+	uint64_t res = 0;
+	std::sort(hands.begin(), hands.end());
+	for(size_t i = 0; i < hands.size(); i++) {
+		res += (i+1) * hands[i].bid();
+	}
+	return res;
+}
+
+
+void parse_lines(parsed& res, const std::string_view lines) {
+	for(const std::string_view line: split_on<"\n">(lines)) {
+		if(line.length() > 0) {
+			const auto [cards, value] = read_record<"{} {}", std::string_view, uint32_t>(line);
+			res.hands.push_back({ std::pmr::string(cards, res.memory->resource()), value });
+		}
+	}
+}
+
+parsed parse(const std::string_view input) {
+	parsed res { std::make_unique<arena>(2 * input.length()) };
+	parse_lines(res, input);
+	return res;
+}
+
+
+/*
+ |  Snapshot sections : one fixed-size record per hand.
+ */
+
+constexpr uint32_t snapshot_day = 7;
+constexpr uint32_t snapshot_layout = 1;
+
+struct hand_record {
+	std::array<char,5> cards;
+	uint32_t bid;
+};
+
+void save(const parsed& input, const std::filesystem::path& path) {
+	std::vector<hand_record> records;
+	records.reserve(input.hands.size());
+	for(const hand& h: input.hands) {
+		if(h.cards.size() != 5) {
+			throw std::runtime_error("hands must have 5 cards to be saved");
+		}
+		hand_record r { {}, h.bid };
+		std::copy(h.cards.begin(), h.cards.end(), r.cards.begin());
+		records.push_back(r);
+	}
+	snapshot_writer writer(snapshot_day, snapshot_layout);
+	writer.add(std::span<const hand_record>(records));
+	writer.write(path);
+}
+
+parsed load(const std::filesystem::path& path) {
+	const snapshot snap(path, snapshot_day, snapshot_layout);
+	const std::span<const hand_record> records = snap.section<hand_record>(0);
+
+	parsed res { std::make_unique<arena>(sizeof(hand) * records.size()) };
+	res.hands.reserve(records.size());
+	for(const hand_record& r: records) {
+		res.hands.push_back({ std::pmr::string(r.cards.data(), r.cards.size(), res.memory->resource()), r.bid });
+	}
+	return res;
+}
+
+
+template <part Part>
+uint64_t solve(const parsed& input) {
+	std::vector<card_hand<Part>> hands;
+	for(const hand& h: input.hands) {
+		hands.emplace_back(h.cards, h.bid);
+	}
+	return winnings(hands);
+}
+
+uint64_t solve_part1(const parsed& input) {
+	return solve<part::one>(input);
+}
+
+uint64_t solve_part2(const parsed& input) {
+	return solve<part::two>(input);
+}
+
+}
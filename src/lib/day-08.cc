@@ -0,0 +1,425 @@
+
+#include <days/day-08.hh>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <tuple>
+
+#include <utils/split.hh>
+#include <utils/record.hh>
+#include <utils/snapshot.hh>
+
+
+namespace day08 {
+
+/*
+ |  Walking one edge at a time costs as many iterations as there are steps.
+ |  Instead, we precompute where each node ends up after one full pass over
+ |  the directions, then after 2, 4, 8, ... passes (binary lifting).
+ |
+ |  For a given destination, we also remember for each node the first offset
+ |  in a pass at which the destination is visited, and whether it is visited
+ |  at all during each power-of-two block of passes. A walk is then a series
+ |  of O(log(passes)) jumps over blocks that miss the destination, followed
+ |  by the offset in the final pass.
+ |
+ |  Since a walk over whole passes is periodic with a period of at most the
+ |  number of nodes, jumps of up to 2^k >= nb_nodes passes are enough.
+ */
+
+pass_table::pass_table(const network& nodes, const std::string& directions): 
+		_nodes(nodes), _directions(directions), _jumps() {
+	const size_t nb_nodes = _nodes.size();
+	size_t nb_levels = 1;
+	while((static_cast<size_t>(1) << (nb_levels - 1)) < nb_nodes) {
+		nb_levels++;
+	}
+
+	_jumps.emplace_back(nb_nodes);
+	#pragma omp parallel for
+	for(size_t i = 0; i < nb_nodes; i++) {
+		uint32_t n = i;
+		for(const char d: _directions) {
+			n = _nodes.follow(n, d);
+		}
+		_jumps[0][i] = n;
+	}
+
+	for(size_t k = 1; k < nb_levels; k++) {
+		const std::vector<uint32_t>& prev = _jumps.back();
+		std::vector<uint32_t> level(nb_nodes);
+		#pragma omp parallel for
+		for(size_t i = 0; i < nb_nodes; i++) {
+			level[i] = prev[prev[i]];
+		}
+		_jumps.push_back(std::move(level));
+	}
+}
+
+std::optional<uint64_t> pass_table::steps(const std::string_view start, const std::string_view destination) {
+	const std::optional<uint32_t> start_index = _nodes.find(start);
+	const std::optional<uint32_t> destination_index = _nodes.find(destination);
+	if(!start_index.has_value() || !destination_index.has_value()) {
+		return std::nullopt;
+	}
+	const destination_hits& hits = hits_for(destination_index.value());
+	uint32_t current = start_index.value();
+	uint64_t nb_passes = 0;
+	if(!hits.in_block.back()[current]) {
+		return std::nullopt;
+	}
+	for(size_t k = _jumps.size(); k > 0; k--) {
+		if(!hits.in_block[k-1][current]) {
+			current = _jumps[k-1][current];
+			nb_passes += static_cast<uint64_t>(1) << (k-1);
+		}
+	}
+	return nb_passes * _directions.size() + hits.first_offset[current];
+}
+
+const pass_table::destination_hits& pass_table::hits_for(const uint32_t destination) {
+	const auto it = _hits.find(destination);
+	if(it != _hits.end()) {
+		return it->second;
+	}
+	const size_t nb_nodes = _nodes.size();
+	destination_hits hits;
+	hits.first_offset.resize(nb_nodes);
+	hits.in_block.emplace_back(nb_nodes);
+	#pragma omp parallel for
+	for(size_t i = 0; i < nb_nodes; i++) {
+		uint32_t n = i;
+		uint32_t offset = 0;
+		for(const char d: _directions) {
+			if(n == destination) {
+				break;
+			}
+			n = _nodes.follow(n, d);
+			offset++;
+		}
+		hits.first_offset[i] = offset;
+		hits.in_block[0][i] = (offset < _directions.size());
+	}
+	for(size_t k = 1; k < _jumps.size(); k++) {
+		const std::vector<uint8_t>& prev = hits.in_block.back();
+		std::vector<uint8_t> level(nb_nodes);
+		#pragma omp parallel for
+		for(size_t i = 0; i < nb_nodes; i++) {
+			level[i] = prev[i] || prev[_jumps[k-1][i]];
+		}
+		hits.in_block.push_back(std::move(level));
+	}
+	return _hits.emplace(destination, std::move(hits)).first->second;
+}
+
+
+
+/*-----------------+
+|  Second Part     |
++------------------*/
+
+
+__extension__ typedef __int128 int128_t;
+
+
+/*
+ |  The state of a walker is the pair (node, position in the directions).
+ |  Since the position only depends on the number of steps, we only need
+ |  to look at the nodes reached at the beginning of each pass over the
+ |  directions : the first time one of them repeats, the walk is cyclic.
+ |
+ |  Any step count at which the walker is on a Z node is then either in
+ |  the prefix (before the cycle), or congruent to one of the hits in the
+ |  cycle modulo the length of the cycle.
+ */
+
+struct walk_cycle {
+	uint64_t cycle_start;
+	uint64_t cycle_length;
+	std::vector<uint64_t> prefix_hits; // sorted, all < cycle_start
+	std::vector<uint64_t> cycle_hits;  // sorted, all in [cycle_start, cycle_start + cycle_length)
+
+	bool on_destination(const uint64_t step) const {
+		if(step < cycle_start) {
+			return std::binary_search(prefix_hits.begin(), prefix_hits.end(), step);
+		}
+		const uint64_t folded = cycle_start + (step - cycle_start) % cycle_length;
+		return std::binary_search(cycle_hits.begin(), cycle_hits.end(), folded);
+	}
+};
+
+walk_cycle analyse_walk(const network& nodes, const uint32_t start, const std::string& directions) {
+	walk_cycle res;
+	std::unordered_map<uint32_t,uint64_t> pass_starts;
+	std::vector<uint64_t> hits;
+	uint64_t step = 0;
+	uint32_t n = start;
+	while(true) {
+		const auto [it, inserted] = pass_starts.try_emplace(n, step);
+		if(!inserted) {
+			res.cycle_start  = it->second;
+			res.cycle_length = step - it->second;
+			break;
+		}
+		for(const char d: directions) {
+			if(nodes.name(n).back() == 'Z') {
+				hits.push_back(step);
+			}
+			n = nodes.follow(n, d);
+			step++;
+		}
+	}
+	for(const uint64_t h: hits) {
+		if(h < res.cycle_start) {
+			res.prefix_hits.push_back(h);
+		} else {
+			res.cycle_hits.push_back(h);
+		}
+	}
+	return res;
+}
+
+
+/*
+ |  Each walker gives a set of residues modulo its cycle length, and the sets
+ |  are combined two by two with the Chinese remainder theorem. Only residues
+ |  that agree modulo the gcd of the moduli are compatible, so the second set
+ |  is bucketed by its residues modulo the gcd : the cost of a combination is
+ |  the number of combined residues (all modulo the lcm, kept sorted and
+ |  distinct), not the product of the sizes of the two sets.
+ */
+
+struct residue_set {
+	uint64_t modulus;
+	std::vector<uint64_t> residues; // sorted, distinct, all < modulus
+};
+
+int128_t modular_inverse(int128_t a, const int128_t m) {
+	int128_t old_r = a % m, r = m;
+	int128_t old_s = 1, s = 0;
+	while(r != 0) {
+		const int128_t q = old_r / r;
+		std::tie(old_r, r) = std::make_pair(r, old_r - q * r);
+		std::tie(old_s, s) = std::make_pair(s, old_s - q * s);
+	}
+	return ((old_s % m) + m) % m;
+}
+
+/// @brief the residues satisfying a residue of each set (moduli need not be coprime)
+/// @note throws if the combined modulus does not fit on 64 bits
+residue_set combine(const residue_set& s1, const residue_set& s2) {
+	const uint64_t g = std::gcd(s1.modulus, s2.modulus);
+	const int128_t lcm = static_cast<int128_t>(s1.modulus / g) * s2.modulus;
+	if(lcm > static_cast<int128_t>(std::numeric_limits<uint64_t>::max())) {
+		throw std::overflow_error("the cycles of the walkers only align after more than 2^64 steps");
+	}
+	const int128_t m2 = s2.modulus / g;
+	const int128_t inverse = modular_inverse(s1.modulus / g, m2);
+
+	std::unordered_map<uint64_t,std::vector<uint64_t>> by_class;
+	for(const uint64_t r2: s2.residues) {
+		by_class[r2 % g].push_back(r2);
+	}
+
+	residue_set res { static_cast<uint64_t>(lcm), {} };
+	for(const uint64_t r1: s1.residues) {
+		const auto it = by_class.find(r1 % g);
+		if(it == by_class.end()) {
+			continue;
+		}
+		for(const uint64_t r2: it->second) {
+			const int128_t diff = static_cast<int128_t>(r2) - static_cast<int128_t>(r1);
+			const int128_t k = (((diff / g) % m2 + m2) % m2) * inverse % m2;
+			res.residues.push_back(static_cast<uint64_t>((r1 + k * s1.modulus) % lcm));
+		}
+	}
+	std::sort(res.residues.begin(), res.residues.end());
+	res.residues.erase(std::unique(res.residues.begin(), res.residues.end()), res.residues.end());
+	return res;
+}
+
+
+std::optional<uint64_t> compute_ghost_steps(const network& nodes, const std::string& directions) {
+	std::vector<uint32_t> starts; // sorted by name, as the nodes are
+	for(uint32_t n = 0; n < nodes.size(); n++) {
+		if(nodes.name(n).back() == 'A') {
+			starts.push_back(n);
+		}
+	}
+	if(starts.empty()) {
+		return std::nullopt;
+	}
+
+	std::vector<walk_cycle> cycles(starts.size());
+	#pragma omp parallel for
+	for(size_t i = 0; i < starts.size(); i++) {
+		cycles[i] = analyse_walk(nodes, starts[i], directions);
+	}
+
+	uint64_t threshold = 0;
+	for(size_t i = 0; i < starts.size(); i++) {
+		threshold = std::max(threshold, cycles[i].cycle_start);
+	}
+
+	// Before every walker is in its cycle, there are few enough steps to check them one by one
+	for(uint64_t step = 0; step < threshold; step++) {
+		if(std::all_of(cycles.begin(), cycles.end(), [step](const walk_cycle& c) { return c.on_destination(step); })) {
+			return step;
+		}
+	}
+
+	// After that, the residues of the walkers are combined two by two
+	std::vector<residue_set> sets;
+	for(const walk_cycle& c: cycles) {
+		residue_set set { c.cycle_length, {} };
+		for(const uint64_t hit: c.cycle_hits) {
+			set.residues.push_back(hit % c.cycle_length);
+		}
+		std::sort(set.residues.begin(), set.residues.end());
+		sets.push_back(std::move(set));
+	}
+	while(sets.size() > 1) {
+		std::vector<residue_set> combined;
+		for(size_t i = 0; i + 1 < sets.size(); i += 2) {
+			combined.push_back(combine(sets[i], sets[i+1]));
+		}
+		if(sets.size() % 2 == 1) {
+			combined.push_back(std::move(sets.back()));
+		}
+		sets = std::move(combined);
+	}
+
+	std::optional<uint64_t> res;
+	const uint64_t modulus = sets[0].modulus;
+	for(const uint64_t residue: sets[0].residues) {
+		// Smallest step >= threshold satisfying the congruence
+		int128_t step = residue;
+		if(step < threshold) {
+			step += static_cast<int128_t>((threshold - residue + modulus - 1) / modulus) * modulus;
+		}
+		if(step > static_cast<int128_t>(std::numeric_limits<uint64_t>::max())) {
+			throw std::overflow_error("the walkers only meet after more than 2^64 steps");
+		}
+		if(!res.has_value() || static_cast<uint64_t>(step) < res.value()) {
+			res = static_cast<uint64_t>(step);
+		}
+	}
+	return res;
+}
+
+
+/// @brief the walks are only cyclic if there is at least one direction
+bool valid_directions(const std::string_view directions) {
+	return !directions.empty() && std::all_of(directions.begin(), directions.end(), [](const char d) { return d == 'L' || d == 'R'; });
+}
+
+
+/*
+ |  The nodes are sorted by name, so that a name is found by binary search in
+ |  the parsed network as well as in a mapped snapshot, and their neighbours
+ |  are linked by index once all the names are known.
+ */
+
+parsed parse(const std::string_view input) {
+	const auto [directions, nodes_repr] = split_once<"\n">(input);
+	if(!valid_directions(directions)) {
+		throw std::runtime_error("the directions must be a non-empty sequence of L and R");
+	}
+	parsed res { std::make_unique<arena>(4 * input.length()), std::string(directions) };
+
+	struct node_repr {
+		std::string_view name;
+		std::string_view left;
+		std::string_view right;
+	};
+	std::pmr::vector<node_repr> reprs(res.memory->resource());
+	size_t names_length = 0;
+	for(const std::string_view line: split_on<"\n">(nodes_repr)) {
+		if(line.length() == 0) {
+			continue;
+		}
+		const auto [name, left_name, right_name] = read_record<"{} = ({}, {})", std::string_view, std::string_view, std::string_view>(line);
+		reprs.push_back({ name, left_name, right_name });
+		names_length += name.length();
+	}
+	std::sort(reprs.begin(), reprs.end(), [](const node_repr& r1, const node_repr& r2) { return r1.name < r2.name; });
+
+	res.names.reserve(names_length);
+	res.records.reserve(reprs.size());
+	for(const node_repr& r: reprs) {
+		res.records.push_back({ static_cast<uint32_t>(res.names.size()), static_cast<uint32_t>(r.name.length()), 0, 0 });
+		res.names.insert(res.names.end(), r.name.begin(), r.name.end());
+	}
+	res.nodes = network(res.names, res.records);
+
+	const auto index_of = [&res](const std::string_view name) {
+		const std::optional<uint32_t> index = res.nodes.find(name);
+		if(!index.has_value()) {
+			throw std::runtime_error("unknown node \"" + std::string(name) + "\"");
+		}
+		return index.value();
+	};
+	for(size_t i = 0; i < reprs.size(); i++) {
+		res.records[i].left = index_of(reprs[i].left);
+		res.records[i].right = index_of(reprs[i].right);
+	}
+	return res;
+}
+
+
+/*
+ |  Snapshot sections : the directions, the names of all the nodes one after
+ |  the other, and the records of the nodes in the order of their names. The
+ |  records are used in place : loading only checks that they are consistent.
+ */
+
+constexpr uint32_t snapshot_day = 8;
+constexpr uint32_t snapshot_layout = 2;
+
+void save(const parsed& input, const std::filesystem::path& path) {
+	snapshot_writer writer(snapshot_day, snapshot_layout);
+	writer.add(std::span<const char>(input.directions));
+	writer.add(input.nodes.names());
+	writer.add(input.nodes.records());
+	writer.write(path);
+}
+
+parsed load(const std::filesystem::path& path) {
+	auto mapping = std::make_unique<const snapshot>(path, snapshot_day, snapshot_layout);
+	const std::span<const char> directions = mapping->section<char>(0);
+	const std::span<const char> names = mapping->section<char>(1);
+	const std::span<const node_record> records = mapping->section<node_record>(2);
+
+	if(!valid_directions(std::string_view(directions.data(), directions.size()))) {
+		throw std::runtime_error("inconsistent snapshot " + path.string());
+	}
+
+	const network nodes(names, records);
+	for(size_t i = 0; i < records.size(); i++) {
+		const node_record& r = records[i];
+		if(static_cast<uint64_t>(r.name_offset) + r.name_length > names.size() || r.name_length == 0
+		   || r.left >= records.size() || r.right >= records.size()
+		   || (i > 0 && nodes.name(i - 1) >= nodes.name(i))) {
+			throw std::runtime_error("inconsistent snapshot " + path.string());
+		}
+	}
+
+	parsed res { std::make_unique<arena>(), std::string(directions.begin(), directions.end()) };
+	res.mapping = std::move(mapping);
+	res.nodes = nodes;
+	return res;
+}
+
+
+std::optional<uint64_t> solve_part1(const parsed& input) {
+	pass_table table(input.nodes, input.directions);
+	return table.steps("AAA", "ZZZ");
+}
+
+std::optional<uint64_t> solve_part2(const parsed& input) {
+	return compute_ghost_steps(input.nodes, input.directions);
+}
+
+}
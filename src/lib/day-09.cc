@@ -0,0 +1,442 @@
+
+#include <days/day-09.hh>
+
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <map>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include <utils/parallel.hh>
+#include <utils/pipeline.hh>
+#include <utils/split.hh>
+
+
+namespace day09 {
+
+enum class part { one, two };
+
+
+std::vector<int32_t> compute_differences(const std::span<const int32_t> values) {
+    std::vector<int32_t> result;
+    for(size_t i = 0; i < values.size() - 1; i++) {
+        result.push_back(values[i+1] - values[i]);
+    }
+    return result;
+}
+
+
+template <part Part>
+int32_t extrapolate(const sequence& values);
+
+template <>
+int32_t extrapolate<part::one>(const sequence& values) {
+    std::vector<std::vector<int32_t>> compute;
+    compute.emplace_back(compute_differences(values));
+    int32_t res = values.back() + compute.back().back();
+    while(std::adjacent_find( compute.back().begin(), compute.back().end(), std::not_equal_to<>() ) != compute.back().end()) {
+        compute.emplace_back(compute_differences(compute.back()));
+        res += compute.back().back();
+    }
+    return res;
+}
+
+template <>
+int32_t extrapolate<part::two>(const sequence& values) {
+    std::vector<std::vector<int32_t>> compute;
+    compute.emplace_back(compute_differences(values));
+    while(std::adjacent_find( compute.back().begin(), compute.back().end(), std::not_equal_to<>() ) != compute.back().end()) {
+        compute.emplace_back(compute_differences(compute.back()));
+    }
+    int32_t res = 0;
+    for(auto it = compute.rbegin(); it != compute.rend(); ++it) {
+        res = it->at(0) - res;
+    }
+    return values[0] - res;
+}
+
+
+template <part Part>
+int64_t extrapolate_sum(const std::pmr::vector<sequence>& values) {
+    return map_reduce(std::span<const sequence>(values), static_cast<int64_t>(0), extrapolate<Part>, std::plus<>());
+}
+
+
+
+/*-----------------+
+|  Closed form     |
++------------------*/
+
+
+/*
+ |  For a sequence x_0, ..., x_{n-1}, extrapolating amounts to assuming that
+ |  the n-th difference is zero :
+ |
+ |      sum_{i=0}^{n} (-1)^(n-i) * C(n, i) * x_i = 0
+ |
+ |  Hence the next value is a fixed combination of the inputs :
+ |
+ |      x_n = sum_{i=0}^{n-1} (-1)^(n-1-i) * C(n, i) * x_i
+ |
+ |  And, shifting the indexes by one, so is the previous value :
+ |
+ |      x_{-1} = sum_{i=0}^{n-1} (-1)^i * C(n, i+1) * x_i
+ |
+ |  If the differences become constant earlier, the higher differences are
+ |  all zero, so this gives the same result as the iterative computation.
+ */
+
+__extension__ typedef __int128 int128_t;
+
+class binomial_extrapolator {
+
+public:
+    template <part Part>
+    int64_t extrapolate(const sequence& values) {
+        const weight_row& w = weights<Part>(values.size());
+        if(!w.exact) {
+            // the binomials no longer fit on 64 bits, the differences are computed instead
+            return extrapolate_differences<Part>(values);
+        }
+
+        // the partial sums are bounded by the sum of the absolute weights times the largest value
+        int64_t max_abs = 0;
+        #pragma omp simd reduction(max:max_abs)
+        for(size_t i = 0; i < values.size(); i++) {
+            max_abs = std::max(max_abs, std::abs(static_cast<int64_t>(values[i])));
+        }
+        if(w.abs_sum * max_abs <= std::numeric_limits<int64_t>::max()) {
+            int64_t res = 0;
+            #pragma omp simd reduction(+:res)
+            for(size_t i = 0; i < values.size(); i++) {
+                res += w.values[i] * static_cast<int64_t>(values[i]);
+            }
+            return res;
+        }
+
+        int128_t res = 0;
+        for(size_t i = 0; i < values.size(); i++) {
+            res += static_cast<int128_t>(w.values[i]) * values[i];
+        }
+        return narrow(res, values.size());
+    }
+
+private:
+    struct weight_row {
+        bool computed = false;
+        bool exact = true;      // false if some binomial does not fit on 64 bits
+        std::vector<int64_t> values;
+        int128_t abs_sum = 0;
+    };
+
+    // Indexed by the length of the sequence
+    std::vector<weight_row> _next_weights;
+    std::vector<weight_row> _previous_weights;
+
+    template <part Part>
+    const weight_row& weights(const size_t n) {
+        std::vector<weight_row>& cache = (Part == part::one) ? _next_weights : _previous_weights;
+        if(cache.size() <= n) {
+            cache.resize(n+1);
+        }
+        weight_row& res = cache[n];
+        if(!res.computed) {
+            res.computed = true;
+            const std::optional<std::vector<int64_t>> row = binomial_row(n);
+            res.exact = row.has_value();
+            if(!res.exact) {
+                return res;
+            }
+            res.values.resize(n);
+            for(size_t i = 0; i < n; i++) {
+                if constexpr(Part == part::one) {
+                    res.values[i] = ((n-1-i) % 2 == 0) ? (*row)[i] : -(*row)[i];
+                } else {
+                    res.values[i] = (i % 2 == 0) ? (*row)[i+1] : -(*row)[i+1];
+                }
+                res.abs_sum += (Part == part::one) ? (*row)[i] : (*row)[i+1];
+            }
+        }
+        return res;
+    }
+
+    static int64_t narrow(const int128_t value, const size_t length) {
+        if(value > std::numeric_limits<int64_t>::max() || value < std::numeric_limits<int64_t>::min()) {
+            throw std::overflow_error("the extrapolated value of a sequence of length " + std::to_string(length) + " does not fit on 64 bits");
+        }
+        return static_cast<int64_t>(value);
+    }
+
+    /// @brief the difference table on 128 bits, for the sequences too long for the weights
+    /// @note the k-th differences are below 2^(k+32), so only sequences of about 96 values and more can overflow
+    template <part Part>
+    static int64_t extrapolate_differences(const sequence& values) {
+        std::vector<int128_t> buffer(values.begin(), values.end());
+        int128_t res = 0;
+        int128_t sign = 1;
+        for(size_t size = buffer.size(); size > 0; size--) {
+            const int128_t term = (Part == part::one) ? buffer[size-1] : sign * buffer[0];
+            bool overflow = __builtin_add_overflow(res, term, &res);
+            sign = -sign;
+            bool constant = true;
+            for(size_t i = 0; i + 1 < size; i++) {
+                constant = constant && (buffer[i+1] == buffer[i]);
+                overflow = __builtin_sub_overflow(buffer[i+1], buffer[i], &buffer[i]) || overflow;
+            }
+            if(overflow) {
+                throw std::overflow_error("the differences of a sequence of length " + std::to_string(values.size()) + " do not fit on 128 bits");
+            }
+            if(constant) {
+                break;
+            }
+        }
+        return narrow(res, values.size());
+    }
+
+    /// @brief C(n, 0), ..., C(n, n), or nullopt if they do not all fit on 64 bits (from n = 67)
+    static std::optional<std::vector<int64_t>> binomial_row(const size_t n) {
+        std::vector<int64_t> row(n+1);
+        int128_t c = 1;
+        for(size_t k = 0; k <= n; k++) {
+            if(c > std::numeric_limits<int64_t>::max()) {
+                return std::nullopt;
+            }
+            row[k] = static_cast<int64_t>(c);
+            c = c * (n - k) / (k + 1); // c < 2^63, so the product fits
+        }
+        return row;
+    }
+
+};
+
+
+template <part Part>
+int64_t extrapolate_sum_closed_form(const std::pmr::vector<sequence>& values) {
+    binomial_extrapolator extrapolator;
+    int64_t res = 0;
+    for(const sequence& v: values) {
+        res += extrapolator.extrapolate<Part>(v);
+    }
+    return res;
+}
+
+
+
+/*-----------------+
+|  Streaming       |
++------------------*/
+
+
+/// @brief reduces the values in place, one level of differences at a time
+/// @note the content of the buffer is destroyed
+extrapolation_sums extrapolate_in_place(std::vector<int64_t>& buffer, size_t size) {
+    extrapolation_sums res;
+    int64_t sign = 1;
+    while(size > 0) {
+        res.next     += buffer[size-1];
+        res.previous += sign * buffer[0];
+        sign = -sign;
+        bool constant = true;
+        for(size_t i = 0; i + 1 < size; i++) {
+            constant = constant && (buffer[i+1] == buffer[i]);
+            buffer[i] = buffer[i+1] - buffer[i];
+        }
+        if(constant) {
+            break;
+        }
+        size--;
+    }
+    return res;
+}
+
+
+bool is_separator(const char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+/// @brief parses the space-separated values of the line in the buffer, which is only grown if needed
+/// @note throws like std::stol on the values that are not numbers or do not fit on 64 bits
+size_t parse_values(const std::string_view line, std::vector<int64_t>& buffer) {
+    size_t size = 0;
+    const char* it  = line.data();
+    const char* end = line.data() + line.size();
+    while(it != end) {
+        if(is_separator(*it)) {
+            ++it;
+            continue;
+        }
+        if(size == buffer.size()) {
+            buffer.push_back(0);
+        }
+        const auto [next, error] = std::from_chars(it, end, buffer[size]);
+        if(error == std::errc::result_out_of_range) {
+            throw std::out_of_range("value out of range : " + std::string(it, std::find_if(it, end, is_separator)));
+        }
+        if(error != std::errc() || (next != end && !is_separator(*next))) {
+            throw std::invalid_argument("not a value : " + std::string(it, std::find_if(it, end, is_separator)));
+        }
+        it = next;
+        size++;
+    }
+    return size;
+}
+
+
+extrapolation_sums solve_streaming(input_source& source) {
+    std::vector<int64_t> buffer;
+    extrapolation_sums sums;
+
+    for_each_line_batch([&buffer, &sums](const std::string_view lines) {
+        size_t begin = 0;
+        while(begin < lines.length()) {
+            size_t end = lines.find('\n', begin);
+            end = (end == std::string_view::npos) ? lines.length() : end;
+            const size_t size = parse_values(lines.substr(begin, end - begin), buffer);
+            const extrapolation_sums line_sums = extrapolate_in_place(buffer, size);
+            sums.next     += line_sums.next;
+            sums.previous += line_sums.previous;
+            begin = end + 1;
+        }
+    }, source);
+
+    return sums;
+}
+
+
+
+/*-----------------+
+|  Batched         |
++------------------*/
+
+
+/*
+ |  Sequences of the same length are processed by groups of batch_lanes,
+ |  transposed so that the i-th values of all the sequences of the group are
+ |  contiguous. Each level of differences is then a loop over the lanes that
+ |  the compiler can vectorise, and both extrapolations are computed at once.
+ |
+ |  We do not stop at the first constant level (that would need to be checked
+ |  for every lane) : the remaining differences are zero and add nothing.
+ */
+
+constexpr size_t batch_lanes = 8;
+
+using lanes = std::array<int64_t,batch_lanes>;
+
+void extrapolate_batch(const std::vector<const sequence*>& batch, std::vector<lanes>& soa, extrapolation_sums& sums) {
+    const size_t n = batch[0]->size();
+    soa.resize(n);
+    for(size_t i = 0; i < n; i++) {
+        for(size_t l = 0; l < batch_lanes; l++) {
+            soa[i][l] = (*batch[l])[i];
+        }
+    }
+
+    lanes next{};
+    lanes previous{};
+    int64_t sign = 1;
+    for(size_t size = n; size > 0; size--) {
+        const lanes& first = soa[0];
+        const lanes& last  = soa[size-1];
+        #pragma omp simd
+        for(size_t l = 0; l < batch_lanes; l++) {
+            next[l]     += last[l];
+            previous[l] += sign * first[l];
+        }
+        sign = -sign;
+        for(size_t i = 0; i + 1 < size; i++) {
+            lanes& current = soa[i];
+            const lanes& following = soa[i+1];
+            #pragma omp simd
+            for(size_t l = 0; l < batch_lanes; l++) {
+                current[l] = following[l] - current[l];
+            }
+        }
+    }
+
+    for(size_t l = 0; l < batch_lanes; l++) {
+        sums.next     += next[l];
+        sums.previous += previous[l];
+    }
+}
+
+
+extrapolation_sums extrapolate_sums_batched(const std::pmr::vector<sequence>& values) {
+    std::map<size_t,std::vector<const sequence*>> by_length;
+    for(const sequence& v: values) {
+        by_length[v.size()].push_back(&v);
+    }
+
+    extrapolation_sums sums;
+    std::vector<lanes> soa;
+    std::vector<int64_t> scratch;
+    std::vector<const sequence*> batch(batch_lanes);
+    for(const auto& [length, sequences]: by_length) {
+        size_t i = 0;
+        for(; i + batch_lanes <= sequences.size(); i += batch_lanes) {
+            std::copy(sequences.begin() + i, sequences.begin() + i + batch_lanes, batch.begin());
+            extrapolate_batch(batch, soa, sums);
+        }
+        // Scalar fallback for the leftovers
+        for(; i < sequences.size(); i++) {
+            scratch.assign(sequences[i]->begin(), sequences[i]->end());
+            const extrapolation_sums line_sums = extrapolate_in_place(scratch, length);
+            sums.next     += line_sums.next;
+            sums.previous += line_sums.previous;
+        }
+    }
+    return sums;
+}
+
+
+void parse_lines(parsed& res, const std::string_view lines) {
+    for(const std::string_view line: split_on<"\n">(lines)) {
+        if(line.length() == 0) {
+            continue;
+        }
+        res.values.emplace_back();
+        for(std::string_view repr: split(line, " ")) {
+            res.values.back().push_back(std::stol(std::string(repr))); // TODO better conversion
+        }
+    }
+}
+
+parsed parse(const std::string_view input) {
+    parsed res { std::make_unique<arena>(2 * input.length()) };
+    parse_lines(res, input);
+    return res;
+}
+
+
+template <part Part>
+int64_t solve(const parsed& input, const engine e) {
+    switch(e) {
+        case engine::closed_form: return extrapolate_sum_closed_form<Part>(input.values);
+        case engine::batched: {
+            const extrapolation_sums sums = extrapolate_sums_batched(input.values);
+            return (Part == part::one) ? sums.next : sums.previous;
+        }
+        default: return extrapolate_sum<Part>(input.values);
+    }
+}
+
+int64_t solve_part1(const parsed& input, const engine e) {
+    return solve<part::one>(input, e);
+}
+
+int64_t solve_part2(const parsed& input, const engine e) {
+    return solve<part::two>(input, e);
+}
+
+extrapolation_sums solve_both(const parsed& input) {
+    return extrapolate_sums_batched(input.values);
+}
+
+}
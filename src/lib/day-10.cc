@@ -0,0 +1,604 @@
+
+#include <days/day-10.hh>
+
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <queue>
+#include <stdexcept>
+#include <string>
+
+#include <utils/split.hh>
+#include <utils/unreachable.hh>
+#include <utils/snapshot.hh>
+
+
+namespace day10 {
+
+pipe_joint joint_from_char(const char c) {
+    switch(c) {
+        case '-': return pipe_joint::lr;
+        case '|': return pipe_joint::bt;
+        case '7': return pipe_joint::bl;
+        case 'F': return pipe_joint::br;
+        case 'J': return pipe_joint::tl;
+        case 'L': return pipe_joint::tr;
+        default:  return pipe_joint::none;
+    }
+}
+
+
+std::ostream& operator<<(std::ostream& out, const coordinate& c) {
+    out << '(' << c.x << ", " << c.y << ')';
+    return out;
+}
+
+std::ostream& operator<<(std::ostream& out, const displacement d) {
+    switch(d) {
+        case displacement::top:    out << "top";    break;
+        case displacement::right:  out << "right";  break;
+        case displacement::bottom: out << "bottom"; break;
+        case displacement::left:   out << "left";   break;
+        default: throw unreachable();
+    }
+    return out;
+}
+
+std::string_view glyph(const pipe_joint p) {
+    switch(p) {
+        case pipe_joint::lr:   return "─";
+        case pipe_joint::bt:   return "│";
+        case pipe_joint::bl:   return "┐";
+        case pipe_joint::br:   return "┌";
+        case pipe_joint::tl:   return "┘";
+        case pipe_joint::tr:   return "└";
+        case pipe_joint::none: return " ";
+    }
+    throw unreachable();
+}
+
+std::ostream& operator<<(std::ostream& out, const pipe_joint p) {
+    out << glyph(p);
+    return out;
+}
+
+std::ostream& operator<<(std::ostream& out, const pipe_layout& layout) {
+    for(size_t y = 0; y < layout.tiles.height(); y++) {
+        for(const pipe_joint joint: layout.tiles.row(y)) {
+            out << glyph(joint);
+        }
+        out << '\n';
+    }
+    return out;
+}
+
+output_buffer& operator<<(output_buffer& out, const pipe_joint p) {
+    return out << glyph(p);
+}
+
+output_buffer& operator<<(output_buffer& out, const pipe_layout& layout) {
+    for(size_t y = 0; y < layout.tiles.height(); y++) {
+        for(const pipe_joint joint: layout.tiles.row(y)) {
+            out << glyph(joint);
+        }
+        out << '\n';
+    }
+    return out;
+}
+
+
+coordinate get_start(const std::vector<std::string>& layout_repr) {
+    coordinate res = {0, 0};
+    for(const std::string& line: layout_repr) {
+        const size_t pos = line.find('S');
+        if(pos != std::string::npos) {
+            res.x = pos;
+            return res;
+        }
+        res.y++;
+    }
+    throw unreachable();
+}
+
+displacement step_after_start(const coordinate& start, const std::vector<std::string>& layout_repr) {
+    if(start.x > 0) {
+        const char left_tile = layout_repr[start.y][start.x-1];
+        if(left_tile == '-' || left_tile == 'F' || left_tile == 'L') {
+            return displacement::left;
+        }
+    }
+    if(start.x < layout_repr[start.y].size() - 1) {
+        const char right_tile = layout_repr[start.y][start.x+1];
+        if(right_tile == '-' || right_tile == '7' || right_tile == 'J') {
+            return displacement::right;
+        }
+    }
+    if(start.y > 0) {
+        const char top_tile = layout_repr[start.y-1][start.x];
+        if(top_tile == '|' || top_tile == '7' || top_tile == 'F') {
+            return displacement::top;
+        }
+    }
+    if(start.y < layout_repr.size() - 1) {
+        const char bottom_tile = layout_repr[start.y+1][start.x];
+        if(bottom_tile == '|' || bottom_tile == 'J' || bottom_tile == 'L') {
+            return displacement::bottom;
+        }
+    }
+    throw unreachable();
+}
+
+/*
+ |  The loop is traced on a flat copy of the grid, padded with a border of
+ |  empty tiles so that no step can leave it. Each step is two table lookups :
+ |  the outgoing displacement, given the tile and the incoming displacement,
+ |  and the offset of the next tile in the flat grid.
+ |
+ |  Transitions that do not follow the pipes (e.g. entering a vertical pipe
+ |  from the side, or an empty tile) lead to a sentinel displacement, which
+ |  moves by zero and ends the walk. It is only checked once the walk is over.
+ */
+
+constexpr uint8_t invalid_displacement = 4;
+
+constexpr std::array<std::array<uint8_t,4>,7> make_transitions() {
+    constexpr uint8_t top    = static_cast<uint8_t>(displacement::top);
+    constexpr uint8_t right  = static_cast<uint8_t>(displacement::right);
+    constexpr uint8_t bottom = static_cast<uint8_t>(displacement::bottom);
+    constexpr uint8_t left   = static_cast<uint8_t>(displacement::left);
+    std::array<std::array<uint8_t,4>,7> res = {};
+    for(std::array<uint8_t,4>& row: res) {
+        row = { invalid_displacement, invalid_displacement, invalid_displacement, invalid_displacement };
+    }
+    // res[joint][incoming] = outgoing
+    res[static_cast<size_t>(pipe_joint::lr)][right]  = right;
+    res[static_cast<size_t>(pipe_joint::lr)][left]   = left;
+    res[static_cast<size_t>(pipe_joint::bt)][top]    = top;
+    res[static_cast<size_t>(pipe_joint::bt)][bottom] = bottom;
+    res[static_cast<size_t>(pipe_joint::bl)][top]    = left;
+    res[static_cast<size_t>(pipe_joint::bl)][right]  = bottom;
+    res[static_cast<size_t>(pipe_joint::br)][top]    = right;
+    res[static_cast<size_t>(pipe_joint::br)][left]   = bottom;
+    res[static_cast<size_t>(pipe_joint::tl)][bottom] = left;
+    res[static_cast<size_t>(pipe_joint::tl)][right]  = top;
+    res[static_cast<size_t>(pipe_joint::tr)][bottom] = right;
+    res[static_cast<size_t>(pipe_joint::tr)][left]   = top;
+    return res;
+}
+
+constexpr std::array<std::array<uint8_t,4>,7> transitions = make_transitions();
+
+/// @brief offsets of the neighbours in the grid, indexed by displacement (and the sentinel)
+std::array<size_t,5> index_deltas(const grid<pipe_joint>& tiles) {
+    // Negative offsets wrap around, which is fine with unsigned arithmetic
+    return {
+        static_cast<size_t>(tiles.offset( 0, -1)),
+        static_cast<size_t>(tiles.offset( 1,  0)),
+        static_cast<size_t>(tiles.offset( 0,  1)),
+        static_cast<size_t>(tiles.offset(-1,  0)),
+        0
+    };
+}
+
+bool is_corner(const pipe_joint p) {
+    return p == pipe_joint::bl || p == pipe_joint::br || p == pipe_joint::tl || p == pipe_joint::tr;
+}
+
+void record_tile(pipe_layout& layout, const coordinate& c) {
+    layout.loop_length++;
+    if(is_corner(layout[c])) {
+        layout.corners.push_back(c);
+    }
+    layout.top_left     = { std::min(layout.top_left.x, c.x),     std::min(layout.top_left.y, c.y)     };
+    layout.bottom_right = { std::max(layout.bottom_right.x, c.x), std::max(layout.bottom_right.y, c.y) };
+    layout.on_loop.set(c.x, c.y, 1);
+}
+
+pipe_layout make_layout(const std::vector<std::string>& layout_repr) {
+    const coordinate start = get_start(layout_repr);
+    displacement displ = step_after_start(start, layout_repr);
+    pipe_layout layout;
+    layout.start_position = start;
+    layout.start_displacement = displ;
+    layout.loop_length = 0;
+    layout.top_left = start;
+    layout.bottom_right = start;
+    size_t width = 0;
+    for(const std::string& line: layout_repr) {
+        width = std::max(width, line.size());
+    }
+    layout.tiles = grid<pipe_joint>(width, layout_repr.size(), pipe_joint::none);
+    layout.on_loop = packed_grid<1>(width, layout_repr.size());
+
+    grid<pipe_joint> all_tiles(width, layout_repr.size(), pipe_joint::none);
+    for(size_t y = 0; y < layout_repr.size(); y++) {
+        std::transform(layout_repr[y].begin(), layout_repr[y].end(), all_tiles.row(y).begin(), joint_from_char);
+    }
+    const std::array<size_t,5> deltas = index_deltas(all_tiles);
+    const size_t start_index = all_tiles.index(start.x, start.y);
+
+    std::vector<size_t> path;
+    uint8_t d = static_cast<uint8_t>(displ);
+    size_t index = start_index + deltas[d];
+    while((index != start_index) & (d != invalid_displacement)) {
+        path.push_back(index);
+        d = transitions[static_cast<size_t>(all_tiles[index])][d];
+        index += deltas[d];
+    }
+    if(d == invalid_displacement) {
+        throw unreachable(); // the pipes do not form a loop
+    }
+    displ = static_cast<displacement>(d);
+
+    for(const size_t i: path) {
+        layout.tiles[i] = all_tiles[i];
+        record_tile(layout, { all_tiles.x_of(i), all_tiles.y_of(i) });
+    }
+    // Use the first and final displacements to compute the true joint at the start
+    if((displ == displacement::bottom || displ == displacement::top) && (layout.start_displacement == displacement::bottom || layout.start_displacement == displacement::top)) {
+        layout[start] = pipe_joint::bt;
+    }
+    if((displ == displacement::left || displ == displacement::right) && (layout.start_displacement == displacement::right || layout.start_displacement == displacement::left)) {
+        layout[start] = pipe_joint::lr;
+    }
+    if((layout.start_displacement == displacement::bottom && displ == displacement::right) || (layout.start_displacement == displacement::left && displ == displacement::top)) {
+        layout[start] = pipe_joint::bl;
+    }
+    if((layout.start_displacement == displacement::bottom && displ == displacement::left) || (layout.start_displacement == displacement::right && displ == displacement::top)) {
+        layout[start] = pipe_joint::br;
+    }
+    if((layout.start_displacement == displacement::top && displ == displacement::right) || (layout.start_displacement == displacement::left && displ == displacement::bottom)) {
+        layout[start] = pipe_joint::tl;
+    }
+    if((layout.start_displacement == displacement::top && displ == displacement::left) || (layout.start_displacement == displacement::right && displ == displacement::bottom)) {
+        layout[start] = pipe_joint::tr;
+    }
+    record_tile(layout, start);
+    return layout;
+}
+
+
+uint64_t steps_to_farthest_point(const pipe_layout& layout) {
+    return (layout.loop_length+1)/2;
+}
+
+
+void propagate(bool& b1, bool& b2) {
+    b1 = b1 || b2;
+    b2 = b1;
+}
+
+void propagate(bool& b1, bool& b2, bool& b3) {
+    b1 = b1 || b2 || b3;
+    b2 = b1;
+    b3 = b1;
+}
+
+void propagate(bool& b1, bool& b2, bool& b3, bool& b4) {
+    b1 = b1 || b2 || b3 || b4;
+    b2 = b1;
+    b3 = b1;
+    b4 = b1;
+}
+
+struct flood_tile {
+    bool tr = false;
+    bool tl = false;
+    bool br = false;
+    bool bl = false;
+    bool pushed = false;
+    bool border = true; // tiles of the border are never pushed, so that we never flood out of the grid
+    pipe_joint joint = pipe_joint::none;
+
+    bool partially_flooded() const { return tr || tl || br || bl; }
+    bool flooded() const { return tr && tl && br && bl; }
+    bool inside() const { return (joint == pipe_joint::none) && !flooded(); }
+
+    /// @brief propagate the values inside the tile
+    void self_propagate() {
+        switch(joint) {
+            case pipe_joint::none: propagate(tl, tr, bl, br);            return;
+            case pipe_joint::lr:   propagate(tl, tr); propagate(bl, br); return;
+            case pipe_joint::bt:   propagate(tl, bl); propagate(tr, br); return;
+            case pipe_joint::tl:   propagate(tr, br, bl);                return;
+            case pipe_joint::tr:   propagate(tl, bl, br);                return;
+            case pipe_joint::bl:   propagate(tl, tr, br);                return;
+            case pipe_joint::br:   propagate(tr, tl, bl);                return;
+            default: return;
+        }
+    }
+};
+
+
+void push_if_needed(const flood_tile& tile, flood_tile& neighbour, const size_t neighbour_index, std::queue<size_t>& flood_queue) {
+    if(!neighbour.pushed && !neighbour.border && tile.partially_flooded()) {
+        flood_queue.push(neighbour_index);
+        neighbour.pushed = true;
+    }
+}
+
+void flood(const size_t index, grid<flood_tile>& flood_compute, std::queue<size_t>& flood_queue) {
+    flood_tile& tile = flood_compute[index];
+    tile.self_propagate();
+    // Propagate with adjacent left tile
+    const size_t left_index = index - 1;
+    flood_tile& left_tile = flood_compute[left_index];
+    if(tile.joint == pipe_joint::none || tile.joint == pipe_joint::bt || tile.joint == pipe_joint::tr || tile.joint == pipe_joint::br) {
+        propagate(tile.tl, tile.bl, left_tile.tr, left_tile.br);
+    } else {
+        propagate(tile.tl, left_tile.tr);
+        propagate(tile.bl, left_tile.br);
+    }
+    push_if_needed(tile, left_tile, left_index, flood_queue);
+    // Propagate with adjacent right tile
+    const size_t right_index = index + 1;
+    flood_tile& right_tile = flood_compute[right_index];
+    if(tile.joint == pipe_joint::none || tile.joint == pipe_joint::bt || tile.joint == pipe_joint::tl || tile.joint == pipe_joint::bl) {
+        propagate(tile.tr, tile.br, right_tile.tl, right_tile.bl);
+    } else {
+        propagate(tile.tr, right_tile.tl);
+        propagate(tile.br, right_tile.bl);
+    }
+    push_if_needed(tile, right_tile, right_index, flood_queue);
+    // Propagate with adjacent top tile
+    const size_t top_index = index - flood_compute.stride();
+    flood_tile& top_tile = flood_compute[top_index];
+    if(tile.joint == pipe_joint::none || tile.joint == pipe_joint::lr || tile.joint == pipe_joint::br || tile.joint == pipe_joint::bl) {
+        propagate(tile.tl, tile.tr, top_tile.bl, top_tile.br);
+    } else {
+        propagate(tile.tl, top_tile.bl);
+        propagate(tile.tr, top_tile.br);
+    }
+    push_if_needed(tile, top_tile, top_index, flood_queue);
+    // Propagate with adjacent bottom tile
+    const size_t bottom_index = index + flood_compute.stride();
+    flood_tile& bottom_tile = flood_compute[bottom_index];
+    if(tile.joint == pipe_joint::none || tile.joint == pipe_joint::lr || tile.joint == pipe_joint::tr || tile.joint == pipe_joint::tl) {
+        propagate(tile.bl, tile.br, bottom_tile.tl, bottom_tile.tr);
+    } else {
+        propagate(tile.bl, bottom_tile.tl);
+        propagate(tile.br, bottom_tile.tr);
+    }
+    push_if_needed(tile, bottom_tile, bottom_index, flood_queue);
+    tile.self_propagate();
+}
+
+uint32_t compute_enclosed_tiles_flood(const pipe_layout& layout) {
+    grid<flood_tile> flood_compute(layout.tiles.width(), layout.tiles.height());
+    for(size_t y = 0; y < layout.tiles.height(); y++) {
+        for(size_t x = 0; x < layout.tiles.width(); x++) {
+            flood_tile& tile = flood_compute(x, y);
+            tile.joint  = layout.tiles(x, y);
+            tile.border = false;
+        }
+    }
+
+    const size_t first = flood_compute.index(0, 0);
+    flood_compute[first].tl = true; // We start flooding from the top left corner of the map
+    std::queue<size_t> flood_queue;
+    flood_queue.push(first);
+    flood_compute[first].pushed = true;
+
+    while(flood_queue.size() > 0) {
+        const size_t current = flood_queue.front();
+        flood_queue.pop();
+        flood(current, flood_compute, flood_queue);
+    }
+
+    uint32_t res = 0;
+    for(size_t y = 0; y < flood_compute.height(); y++) {
+        for(const flood_tile& tile: flood_compute.row(y)) {
+            if(tile.inside()) {
+                res++;
+            }
+        }
+    }
+    return res;
+}
+
+
+/*-----------------+
+|  Shoelace        |
++------------------*/
+
+
+/*
+ |  The loop is a simple polygon whose vertices are the centres of its corner
+ |  tiles. The shoelace formula gives its area A :
+ |
+ |      2A = | sum_i (x_i * y_{i+1} - x_{i+1} * y_i) |
+ |
+ |  All the vertices have integer coordinates, so Pick's theorem applies :
+ |
+ |      A = i + b/2 - 1
+ |
+ |  Where b is the number of integer points on the boundary, i.e. the length
+ |  of the loop, and i is the number of integer points inside the polygon,
+ |  i.e. the number of enclosed tiles. Hence :
+ |
+ |      i = A - b/2 + 1 = (2A - b + 2) / 2
+ */
+
+int64_t cross(const coordinate& c1, const coordinate& c2) {
+    return static_cast<int64_t>(c1.x) * static_cast<int64_t>(c2.y) - static_cast<int64_t>(c2.x) * static_cast<int64_t>(c1.y);
+}
+
+uint64_t compute_enclosed_tiles_shoelace(const pipe_layout& layout) {
+    int64_t twice_area = 0;
+    coordinate previous_corner = layout.corners.back();
+    for(const coordinate& corner: layout.corners) {
+        twice_area += cross(previous_corner, corner);
+        previous_corner = corner;
+    }
+    twice_area = (twice_area < 0) ? -twice_area : twice_area;
+    return static_cast<uint64_t>(twice_area - static_cast<int64_t>(layout.loop_length) + 2) / 2;
+}
+
+
+/*-----------------+
+|  Scanline        |
++------------------*/
+
+
+/*
+ |  Walking along a row from the left, we cross the loop each time we go over
+ |  a tile that connects to the tile above it (|, L or J). Tiles that are not
+ |  part of the loop are inside if and only if we crossed it an odd number of
+ |  times. Considering only the tiles connected to the top ensures that
+ |  horizontal runs such as L--7 count as one crossing, and L--J as none.
+ |
+ |  The rows are independent, so they are processed in parallel.
+ */
+
+
+inside_mask classify_scanline(const pipe_layout& layout) {
+    inside_mask mask(layout.tiles.width(), layout.tiles.height());
+
+    // Nothing outside of the bounding box of the loop can be inside
+    #pragma omp parallel for schedule(static)
+    for(size_t y = layout.top_left.y; y <= layout.bottom_right.y; y++) {
+        const std::span<const pipe_joint> line = layout.tiles.row(y);
+        const std::span<uint64_t> bits = mask.row(y);
+        uint32_t count = 0;
+        bool inside = false;
+        for(size_t x = layout.top_left.x; x <= layout.bottom_right.x; x++) {
+            const pipe_joint joint = line[x];
+            if(joint == pipe_joint::none) {
+                bits[x / 64] |= static_cast<uint64_t>(inside) << (x % 64);
+                count += inside;
+            } else if(joint == pipe_joint::bt || joint == pipe_joint::tl || joint == pipe_joint::tr) {
+                inside = !inside;
+            }
+        }
+        mask.row_count(y) = count;
+    }
+
+    return mask;
+}
+
+
+uint64_t compute_enclosed_tiles(const pipe_layout& layout) {
+    return classify_scanline(layout).count();
+}
+
+
+void render(output_buffer& out, const pipe_layout& layout, const inside_mask& mask) {
+    for(size_t y = 0; y < layout.tiles.height(); y++) {
+        for(size_t x = 0; x < layout.tiles.width(); x++) {
+            if(mask[{x, y}]) {
+                out << 'O';
+            } else {
+                out << glyph(layout.tiles(x, y));
+            }
+        }
+        out << '\n';
+    }
+}
+
+
+parsed parse(const std::string_view input) {
+    std::vector<std::string> layout_repr;
+    for(const std::string_view line: split(input, "\n")) {
+        if(line.length() > 0) {
+            layout_repr.emplace_back(line);
+        }
+    }
+    return make_layout(layout_repr);
+}
+
+
+/*
+ |  Snapshot sections : the scalar fields of the layout, the tiles including
+ |  their border, the corners, and the words of the on-loop bitmap.
+ */
+
+constexpr uint32_t snapshot_day = 10;
+constexpr uint32_t snapshot_layout = 1;
+
+struct layout_record {
+    uint64_t width;
+    uint64_t height;
+    coordinate start_position;
+    uint64_t start_displacement;
+    uint64_t loop_length;
+    coordinate top_left;
+    coordinate bottom_right;
+};
+
+void save(const parsed& input, const std::filesystem::path& path) {
+    const layout_record record {
+        input.tiles.width(), input.tiles.height(),
+        input.start_position, static_cast<uint64_t>(input.start_displacement),
+        input.loop_length, input.top_left, input.bottom_right
+    };
+    snapshot_writer writer(snapshot_day, snapshot_layout);
+    writer.add_value(record);
+    writer.add(std::span<const pipe_joint>(input.tiles.data(), input.tiles.size()));
+    writer.add(std::span<const coordinate>(input.corners));
+    writer.add(input.on_loop.words());
+    writer.write(path);
+}
+
+/// @brief whether the fields of a loaded layout are within its grid, so that the solvers can trust them
+bool is_consistent(const pipe_layout& layout) {
+    const size_t width = layout.tiles.width();
+    const size_t height = layout.tiles.height();
+    const auto in_box = [&layout](const coordinate& c) {
+        return c.x >= layout.top_left.x && c.x <= layout.bottom_right.x && c.y >= layout.top_left.y && c.y <= layout.bottom_right.y;
+    };
+    if(layout.bottom_right.x >= width || layout.bottom_right.y >= height
+       || layout.top_left.x > layout.bottom_right.x || layout.top_left.y > layout.bottom_right.y
+       || !in_box(layout.start_position) || layout.corners.empty() || layout.loop_length > width * height) {
+        return false;
+    }
+    for(const coordinate& c: layout.corners) {
+        if(!in_box(c) || !is_corner(layout.tiles(c.x, c.y))) {
+            return false;
+        }
+    }
+    // the joints index the transition tables
+    return std::all_of(layout.tiles.data(), layout.tiles.data() + layout.tiles.size(), [](const pipe_joint p) { return p <= pipe_joint::none; });
+}
+
+parsed load(const std::filesystem::path& path) {
+    const snapshot snap(path, snapshot_day, snapshot_layout);
+    const layout_record& record = snap.value<layout_record>(0);
+    const std::span<const pipe_joint> tiles = snap.section<pipe_joint>(1);
+    const std::span<const coordinate> corners = snap.section<coordinate>(2);
+    const std::span<const uint64_t> on_loop = snap.section<uint64_t>(3);
+
+    pipe_layout res;
+    res.tiles = grid<pipe_joint>(record.width, record.height, pipe_joint::none);
+    res.on_loop = packed_grid<1>(record.width, record.height);
+    if(tiles.size() != res.tiles.size() || on_loop.size() != res.on_loop.words().size() || record.start_displacement > static_cast<uint64_t>(displacement::left)) {
+        throw std::runtime_error("inconsistent snapshot " + path.string());
+    }
+    std::memcpy(res.tiles.data(), tiles.data(), tiles.size_bytes());
+    std::memcpy(res.on_loop.words().data(), on_loop.data(), on_loop.size_bytes());
+    res.corners.assign(corners.begin(), corners.end());
+    res.start_position = record.start_position;
+    res.start_displacement = static_cast<displacement>(record.start_displacement);
+    res.loop_length = record.loop_length;
+    res.top_left = record.top_left;
+    res.bottom_right = record.bottom_right;
+    if(!is_consistent(res)) {
+        throw std::runtime_error("inconsistent snapshot " + path.string());
+    }
+    return res;
+}
+
+
+uint64_t solve_part1(const parsed& input) {
+    return steps_to_farthest_point(input);
+}
+
+uint64_t solve_part2(const parsed& input, const engine e) {
+    switch(e) {
+        case engine::shoelace: return compute_enclosed_tiles_shoelace(input);
+        case engine::flood:    return compute_enclosed_tiles_flood(input);
+        default:               return compute_enclosed_tiles(input);
+    }
+}
+
+}
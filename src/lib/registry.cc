@@ -0,0 +1,72 @@
+
+#include <days/registry.hh>
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+
+#include <days/day-01.hh>
+#include <days/day-02.hh>
+#include <days/day-03.hh>
+#include <days/day-04.hh>
+#include <days/day-05.hh>
+#include <days/day-06.hh>
+#include <days/day-07.hh>
+#include <days/day-08.hh>
+#include <days/day-09.hh>
+#include <days/day-10.hh>
+
+#include <utils/perf.hh>
+
+
+namespace {
+
+template <typename T>
+std::optional<std::string> to_result(const T& value) {
+    return std::to_string(value);
+}
+
+template <typename T>
+std::optional<std::string> to_result(const std::optional<T>& value) {
+    if(!value.has_value()) {
+        return std::nullopt;
+    }
+    return std::to_string(value.value());
+}
+
+/// @brief adapts the parse / solve_part1 / solve_part2 functions of a day's namespace
+#define DAY_SOLVER(nb) day_solver {                                                       \
+    #nb,                                                                                  \
+    [](const std::string_view input, const bool part2) -> std::optional<std::string> {   \
+        const auto parsed = measured("parse", input.length(), [input]() {                 \
+            return day##nb::parse(input);                                                 \
+        });                                                                               \
+        const perf_phase phase(part2 ? "solve part 2" : "solve part 1", input.length());  \
+        return part2 ? to_result(day##nb::solve_part2(parsed))                            \
+                     : to_result(day##nb::solve_part1(parsed));                           \
+    }                                                                                     \
+}
+
+const std::array<day_solver,10> days = {
+    DAY_SOLVER(01), DAY_SOLVER(02), DAY_SOLVER(03), DAY_SOLVER(04), DAY_SOLVER(05),
+    DAY_SOLVER(06), DAY_SOLVER(07), DAY_SOLVER(08), DAY_SOLVER(09), DAY_SOLVER(10)
+};
+
+#undef DAY_SOLVER
+
+}
+
+
+std::span<const day_solver> all_days() {
+    return days;
+}
+
+const day_solver* find_day(const std::string_view day) {
+    uint32_t nb = 0;
+    const char* end = day.data() + day.length();
+    const auto [ptr, ec] = std::from_chars(day.data(), end, nb);
+    if(ec != std::errc() || ptr != end || nb == 0 || nb > days.size()) {
+        return nullptr;
+    }
+    return &days[nb - 1];
+}
@@ -0,0 +1,62 @@
+
+#include <days/day-09.hh>
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+
+
+/*
+ |  Sequences longer than 66 values, for which the binomial weights no longer
+ |  fit on 64 bits : every engine must give the exact extrapolations.
+ */
+
+std::string powers(const size_t length, const int exponent) {
+    std::string res;
+    for(size_t i = 0; i < length; i++) {
+        int64_t v = 1;
+        for(int e = 0; e < exponent; e++) {
+            v *= static_cast<int64_t>(i);
+        }
+        res += (i == 0 ? "" : " ") + std::to_string(v);
+    }
+    return res + '\n';
+}
+
+int64_t power(const int64_t i, const int exponent) {
+    int64_t res = 1;
+    for(int e = 0; e < exponent; e++) {
+        res *= i;
+    }
+    return res;
+}
+
+
+int main() {
+    int failures = 0;
+    const auto expect = [&failures](const char* what, const int64_t actual, const int64_t expected) {
+        if(actual != expected) {
+            std::cerr << what << " : got " << actual << ", expected " << expected << std::endl;
+            failures++;
+        }
+    };
+
+    // the values are read on 32 bits, up to 73^5 and 99^4
+    const std::pair<size_t,int> cases[] = { {66, 5}, {67, 5}, {74, 5}, {100, 4} };
+    for(const auto& [length, exponent]: cases) {
+        const day09::parsed input = day09::parse(powers(length, exponent));
+        const int64_t next     = power(static_cast<int64_t>(length), exponent);
+        const int64_t previous = power(-1, exponent);
+        for(const day09::engine e: {day09::engine::iterative, day09::engine::closed_form, day09::engine::batched}) {
+            if(e == day09::engine::iterative && next > INT32_MAX) {
+                continue; // the reference engine computes on 32 bits
+            }
+            const std::string what = "length " + std::to_string(length) + ", exponent " + std::to_string(exponent) + ", engine " + std::to_string(static_cast<int>(e));
+            expect((what + ", next").c_str(),     day09::solve_part1(input, e), next);
+            expect((what + ", previous").c_str(), day09::solve_part2(input, e), previous);
+        }
+    }
+
+    return (failures == 0) ? 0 : 1;
+}